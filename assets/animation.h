@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstdint>
-#include <vector>
 
 // Holds data for a single sprite frame
 struct SpriteFrame {
@@ -10,17 +9,86 @@ struct SpriteFrame {
     const uint16_t* data = nullptr; // Pointer to pixel data array
 };
 
-// Represents a sequence of frames for an animation
+// One step of a clip: which of the character's sprites to show, and for how long
+struct AnimFrameRef {
+    uint8_t sprite;
+    uint16_t duration_ms;
+};
+
+// Sprite-space bounding rect of the pixels a frame changes relative to the frame before it
+struct AnimFrameDiff {
+    uint16_t x, y, w, h; // w = 0: identical frames
+};
+
+// A clip's slice of the static frame tables (see animation_manifest.h)
+struct AnimClipDef {
+    uint16_t first_frame;
+    uint8_t frame_count; // 0 = the character has no such clip
+    bool loops;
+    uint32_t total_ms;   // Sum of the clip's frame durations
+};
+
+// Lightweight view of one clip over static tables; copying it is free and nothing is allocated
 struct Animation {
-    std::vector<SpriteFrame> frames;
-    std::vector<uint32_t> frame_durations_ms; // Duration for each frame in milliseconds
+    const AnimFrameRef* frame_refs = nullptr;   // frame_count entries
+    const uint32_t* frame_start_ms = nullptr;   // Prefix sums of the durations, frame_count entries
+    const AnimFrameDiff* frame_diffs = nullptr; // Change since the previous frame, frame_count entries (optional)
+    const SpriteFrame* sprites = nullptr;       // The character's (resident) sprites, indexed by AnimFrameRef::sprite
+    int frame_count = 0;
     bool loops = true; // Does the animation loop?
-    uint32_t total_duration = 0; // Can be calculated or set manually
+    uint32_t total_duration = 0;
+
+    constexpr bool empty() const { return frame_count == 0; }
+    constexpr const SpriteFrame& frame(int i) const { return sprites[frame_refs[i].sprite]; }
+    constexpr uint32_t frameDuration(int i) const { return frame_refs[i].duration_ms; }
+    constexpr uint32_t frameStart(int i) const { return frame_start_ms[i]; }
+    // The frame shown before frame i when playing in order (clips wrap to their start)
+    constexpr int previousFrame(int i) const { return i > 0 ? i - 1 : frame_count - 1; }
+};
+
+// Builds a view of 'clip' within the given frame tables
+constexpr Animation makeAnimation(const AnimClipDef& clip, const AnimFrameRef* frame_refs,
+                                  const uint32_t* frame_start_ms, const SpriteFrame* sprites,
+                                  const AnimFrameDiff* frame_diffs = nullptr) {
+    Animation anim;
+    if (clip.frame_count == 0) return anim;
+    anim.frame_refs = frame_refs + clip.first_frame;
+    anim.frame_start_ms = frame_start_ms + clip.first_frame;
+    anim.frame_diffs = frame_diffs ? frame_diffs + clip.first_frame : nullptr;
+    anim.sprites = sprites;
+    anim.frame_count = clip.frame_count;
+    anim.loops = clip.loops;
+    anim.total_duration = clip.total_ms;
+    return anim;
+}
+
+// Where an animation is at a given time since it started
+struct AnimSample {
+    int frame = 0;       // Frame to show
+    uint32_t cycles = 0; // Full passes through the clip completed so far
+};
+
+// Samples 'anim' at 'elapsed_ms' after it started: O(1) for the cycle count plus a binary
+// search over the prefix-summed frame starts. Stateless, so any number of entities can share
+// a clip, and a long stall simply lands on the right frame with the right cycle count.
+// Non-looping clips hold their last frame once the first cycle completes.
+constexpr AnimSample sampleAnimation(const Animation& anim, uint32_t elapsed_ms) {
+    AnimSample sample;
+    if (anim.frame_count == 0 || anim.total_duration == 0) return sample;
+
+    sample.cycles = elapsed_ms / anim.total_duration;
+    if (!anim.loops && sample.cycles > 0) {
+        sample.frame = anim.frame_count - 1;
+        return sample;
+    }
 
-    // Helper to add a frame easily
-    void addFrame(const SpriteFrame& frame, uint32_t duration_ms) {
-        frames.push_back(frame);
-        frame_durations_ms.push_back(duration_ms);
-        total_duration += duration_ms;
+    // Last frame whose start time is <= t
+    uint32_t t = elapsed_ms % anim.total_duration;
+    int lo = 0, hi = anim.frame_count - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (anim.frame_start_ms[mid] <= t) lo = mid; else hi = mid - 1;
     }
-}
\ No newline at end of file
+    sample.frame = lo;
+    return sample;
+}
@@ -0,0 +1,111 @@
+// Generated by build_animation_manifest.py from animations.manifest - do not edit
+
+#ifndef ANIMATION_MANIFEST_H
+#define ANIMATION_MANIFEST_H
+
+#include <cstdint>
+#include "animation.h" // AnimFrameRef, AnimFrameDiff, AnimClipDef
+
+enum DigimonType {
+    DIGI_AGUMON,
+    DIGI_GABUMON,
+    DIGI_BIYOMON,
+    DIGI_GATOMON,
+    DIGI_GOMAMON,
+    DIGI_PALMON,
+    DIGI_TENTOMON,
+    DIGI_PATAMON,
+    DIGI_COUNT
+};
+
+enum AnimAction {
+    ACTION_IDLE,
+    ACTION_WALK,
+    ACTION_RUN,
+    ACTION_HAPPY,
+    ACTION_REST,
+    ACTION_ATTACK,
+    ACTION_TURN,
+    ACTION_COUNT
+};
+
+#define ANIMATION_MANIFEST_FRAME_COUNT 136
+
+// { sprite, duration_ms } for every clip, back to back
+inline constexpr AnimFrameRef kAnimFrameRefs[ANIMATION_MANIFEST_FRAME_COUNT] = {
+    { 0, 1000 }, { 1, 1000 }, { 2, 300 }, { 3, 300 }, { 2, 300 }, { 3, 300 }, { 4, 150 }, { 5, 150 },
+    { 4, 150 }, { 5, 150 }, { 6, 400 }, { 0, 400 }, { 6, 400 }, { 7, 1500 }, { 0, 150 }, { 8, 500 },
+    { 9, 200 }, { 0, 1100 }, { 1, 1100 }, { 2, 320 }, { 3, 320 }, { 2, 320 }, { 3, 320 }, { 4, 160 },
+    { 5, 160 }, { 4, 160 }, { 5, 160 }, { 6, 400 }, { 0, 400 }, { 6, 400 }, { 7, 1500 }, { 0, 150 },
+    { 8, 500 }, { 9, 200 }, { 0, 960 }, { 1, 960 }, { 2, 280 }, { 3, 280 }, { 2, 280 }, { 3, 280 },
+    { 4, 140 }, { 5, 140 }, { 4, 140 }, { 5, 140 }, { 6, 400 }, { 0, 400 }, { 6, 400 }, { 7, 1500 },
+    { 0, 150 }, { 8, 500 }, { 9, 200 }, { 0, 1200 }, { 1, 1200 }, { 2, 340 }, { 3, 340 }, { 2, 340 },
+    { 3, 340 }, { 4, 170 }, { 5, 170 }, { 4, 170 }, { 5, 170 }, { 6, 400 }, { 0, 400 }, { 6, 400 },
+    { 7, 1500 }, { 0, 150 }, { 8, 500 }, { 9, 200 }, { 0, 1040 }, { 1, 1040 }, { 2, 310 }, { 3, 310 },
+    { 2, 310 }, { 3, 310 }, { 4, 155 }, { 5, 155 }, { 4, 155 }, { 5, 155 }, { 6, 400 }, { 0, 400 },
+    { 6, 400 }, { 7, 1500 }, { 0, 150 }, { 8, 500 }, { 9, 200 }, { 0, 1080 }, { 1, 1080 }, { 2, 330 },
+    { 3, 330 }, { 2, 330 }, { 3, 330 }, { 4, 165 }, { 5, 165 }, { 4, 165 }, { 5, 165 }, { 6, 400 },
+    { 0, 400 }, { 6, 400 }, { 7, 1500 }, { 0, 150 }, { 8, 500 }, { 9, 200 }, { 0, 920 }, { 1, 920 },
+    { 2, 290 }, { 3, 290 }, { 2, 290 }, { 3, 290 }, { 4, 145 }, { 5, 145 }, { 4, 145 }, { 5, 145 },
+    { 6, 400 }, { 0, 400 }, { 6, 400 }, { 7, 1500 }, { 0, 150 }, { 8, 500 }, { 9, 200 }, { 0, 1060 },
+    { 1, 1060 }, { 2, 300 }, { 3, 300 }, { 2, 300 }, { 3, 300 }, { 4, 150 }, { 5, 150 }, { 4, 150 },
+    { 5, 150 }, { 6, 400 }, { 0, 400 }, { 6, 400 }, { 7, 1500 }, { 0, 150 }, { 8, 500 }, { 9, 200 },
+};
+
+// Start of each frame relative to its clip (prefix sum of durations)
+inline constexpr uint32_t kAnimFrameStartMs[ANIMATION_MANIFEST_FRAME_COUNT] = {
+    0, 1000, 0, 300, 600, 900, 0, 150, 300, 450, 0, 400,
+    800, 0, 0, 150, 0, 0, 1100, 0, 320, 640, 960, 0,
+    160, 320, 480, 0, 400, 800, 0, 0, 150, 0, 0, 960,
+    0, 280, 560, 840, 0, 140, 280, 420, 0, 400, 800, 0,
+    0, 150, 0, 0, 1200, 0, 340, 680, 1020, 0, 170, 340,
+    510, 0, 400, 800, 0, 0, 150, 0, 0, 1040, 0, 310,
+    620, 930, 0, 155, 310, 465, 0, 400, 800, 0, 0, 150,
+    0, 0, 1080, 0, 330, 660, 990, 0, 165, 330, 495, 0,
+    400, 800, 0, 0, 150, 0, 0, 920, 0, 290, 580, 870,
+    0, 145, 290, 435, 0, 400, 800, 0, 0, 150, 0, 0,
+    1060, 0, 300, 600, 900, 0, 150, 300, 450, 0, 400, 800,
+    0, 0, 150, 0,
+};
+
+// { x, y, w, h } sprite-space rect of the pixels that differ from the previous frame in the clip
+// (the last frame, for the first); w = 0 if the frames are identical
+inline constexpr AnimFrameDiff kAnimFrameDiffs[ANIMATION_MANIFEST_FRAME_COUNT] = {
+    { 42, 87, 93, 105 }, { 42, 87, 93, 105 }, { 42, 87, 105, 105 }, { 42, 87, 105, 105 }, { 42, 87, 105, 105 }, { 42, 87, 105, 105 },
+    { 42, 87, 111, 105 }, { 42, 87, 111, 105 }, { 42, 87, 111, 105 }, { 42, 87, 111, 105 }, { 0, 0, 0, 0 }, { 42, 87, 114, 90 },
+    { 42, 87, 114, 90 }, { 0, 0, 0, 0 }, { 33, 87, 120, 105 }, { 33, 87, 120, 105 }, { 0, 0, 0, 0 }, { 45, 78, 117, 114 },
+    { 45, 78, 117, 114 }, { 45, 78, 117, 114 }, { 45, 78, 117, 114 }, { 45, 78, 117, 114 }, { 45, 78, 117, 114 }, { 39, 75, 120, 117 },
+    { 39, 75, 120, 117 }, { 39, 75, 120, 117 }, { 39, 75, 120, 117 }, { 0, 0, 0, 0 }, { 45, 72, 117, 117 }, { 45, 72, 117, 117 },
+    { 0, 0, 0, 0 }, { 42, 75, 120, 117 }, { 42, 75, 120, 117 }, { 0, 0, 0, 0 }, { 45, 72, 111, 108 }, { 45, 72, 111, 108 },
+    { 42, 78, 120, 111 }, { 42, 78, 120, 111 }, { 42, 78, 120, 111 }, { 42, 78, 120, 111 }, { 39, 78, 117, 114 }, { 39, 78, 117, 114 },
+    { 39, 78, 117, 114 }, { 39, 78, 117, 114 }, { 0, 0, 0, 0 }, { 39, 72, 120, 120 }, { 39, 72, 120, 120 }, { 0, 0, 0, 0 },
+    { 24, 69, 138, 123 }, { 24, 69, 138, 123 }, { 0, 0, 0, 0 }, { 33, 78, 138, 108 }, { 33, 78, 138, 108 }, { 24, 81, 150, 111 },
+    { 24, 81, 150, 111 }, { 24, 81, 150, 111 }, { 24, 81, 150, 111 }, { 12, 66, 177, 126 }, { 12, 66, 177, 126 }, { 12, 66, 177, 126 },
+    { 12, 66, 177, 126 }, { 0, 0, 0, 0 }, { 33, 78, 147, 114 }, { 33, 78, 147, 114 }, { 0, 0, 0, 0 }, { 6, 78, 183, 114 },
+    { 6, 78, 183, 114 }, { 0, 0, 0, 0 }, { 36, 72, 123, 114 }, { 36, 72, 123, 114 }, { 30, 72, 129, 120 }, { 30, 72, 129, 120 },
+    { 30, 72, 129, 120 }, { 30, 72, 129, 120 }, { 27, 72, 153, 114 }, { 27, 72, 153, 114 }, { 27, 72, 153, 114 }, { 27, 72, 153, 114 },
+    { 0, 0, 0, 0 }, { 30, 63, 132, 129 }, { 30, 63, 132, 129 }, { 0, 0, 0, 0 }, { 15, 57, 159, 135 }, { 15, 57, 159, 135 },
+    { 0, 0, 0, 0 }, { 39, 72, 108, 120 }, { 39, 72, 108, 120 }, { 39, 72, 108, 120 }, { 39, 72, 108, 120 }, { 39, 72, 108, 120 },
+    { 39, 72, 108, 120 }, { 27, 72, 120, 120 }, { 27, 72, 120, 120 }, { 27, 72, 120, 120 }, { 27, 72, 120, 120 }, { 0, 0, 0, 0 },
+    { 33, 69, 117, 123 }, { 33, 69, 117, 123 }, { 0, 0, 0, 0 }, { 27, 72, 117, 120 }, { 27, 72, 117, 120 }, { 0, 0, 0, 0 },
+    { 24, 69, 138, 120 }, { 24, 69, 138, 120 }, { 15, 72, 159, 117 }, { 15, 72, 159, 117 }, { 15, 72, 159, 117 }, { 15, 72, 159, 117 },
+    { 33, 69, 135, 123 }, { 33, 69, 135, 123 }, { 33, 69, 135, 123 }, { 33, 69, 135, 123 }, { 0, 0, 0, 0 }, { 21, 66, 156, 126 },
+    { 21, 66, 156, 126 }, { 0, 0, 0, 0 }, { 15, 63, 159, 129 }, { 15, 63, 159, 129 }, { 0, 0, 0, 0 }, { 36, 84, 111, 105 },
+    { 36, 84, 111, 105 }, { 33, 81, 114, 111 }, { 33, 81, 114, 111 }, { 33, 81, 114, 111 }, { 33, 81, 114, 111 }, { 39, 63, 108, 108 },
+    { 39, 63, 108, 108 }, { 39, 63, 108, 108 }, { 39, 63, 108, 108 }, { 0, 0, 0, 0 }, { 30, 84, 114, 102 }, { 30, 84, 114, 102 },
+    { 0, 0, 0, 0 }, { 33, 84, 111, 108 }, { 33, 84, 111, 108 }, { 0, 0, 0, 0 },
+};
+
+// { first_frame, frame_count, loops, total_ms } per [character][action]; frame_count 0 = no clip
+inline constexpr AnimClipDef kAnimClips[DIGI_COUNT][ACTION_COUNT] = {
+    { { 0, 2, true, 2000 }, { 2, 4, false, 1200 }, { 6, 4, false, 600 }, { 10, 3, false, 1200 }, { 13, 1, true, 1500 }, { 14, 2, false, 650 }, { 16, 1, false, 200 }, }, // Agumon
+    { { 17, 2, true, 2200 }, { 19, 4, false, 1280 }, { 23, 4, false, 640 }, { 27, 3, false, 1200 }, { 30, 1, true, 1500 }, { 31, 2, false, 650 }, { 33, 1, false, 200 }, }, // Gabumon
+    { { 34, 2, true, 1920 }, { 36, 4, false, 1120 }, { 40, 4, false, 560 }, { 44, 3, false, 1200 }, { 47, 1, true, 1500 }, { 48, 2, false, 650 }, { 50, 1, false, 200 }, }, // Biyomon
+    { { 51, 2, true, 2400 }, { 53, 4, false, 1360 }, { 57, 4, false, 680 }, { 61, 3, false, 1200 }, { 64, 1, true, 1500 }, { 65, 2, false, 650 }, { 67, 1, false, 200 }, }, // Gatomon
+    { { 68, 2, true, 2080 }, { 70, 4, false, 1240 }, { 74, 4, false, 620 }, { 78, 3, false, 1200 }, { 81, 1, true, 1500 }, { 82, 2, false, 650 }, { 84, 1, false, 200 }, }, // Gomamon
+    { { 85, 2, true, 2160 }, { 87, 4, false, 1320 }, { 91, 4, false, 660 }, { 95, 3, false, 1200 }, { 98, 1, true, 1500 }, { 99, 2, false, 650 }, { 101, 1, false, 200 }, }, // Palmon
+    { { 102, 2, true, 1840 }, { 104, 4, false, 1160 }, { 108, 4, false, 580 }, { 112, 3, false, 1200 }, { 115, 1, true, 1500 }, { 116, 2, false, 650 }, { 118, 1, false, 200 }, }, // Tentomon
+    { { 119, 2, true, 2120 }, { 121, 4, false, 1200 }, { 125, 4, false, 600 }, { 129, 3, false, 1200 }, { 132, 1, true, 1500 }, { 133, 2, false, 650 }, { 135, 1, false, 200 }, }, // Patamon
+};
+
+#endif // ANIMATION_MANIFEST_H
@@ -0,0 +1,199 @@
+// Generated by build_animation_manifest.py from animations.manifest - do not edit
+// Defines the sprite tables, so include it from exactly one .cpp file
+
+#ifndef ANIMATION_MANIFEST_DATA_H
+#define ANIMATION_MANIFEST_DATA_H
+
+#include <cstdint>
+#include "DigimonRoster.h" // DigimonDef, generated enums
+
+#include "Agumon_Idle_0.h"
+#include "Agumon_Idle_1.h"
+#include "Agumon_Walk_0.h"
+#include "Agumon_Walk_1.h"
+#include "Agumon_Run_0.h"
+#include "Agumon_Run_1.h"
+#include "Agumon_Happy_0.h"
+#include "Agumon_Rest_0.h"
+#include "Agumon_Attack_0.h"
+#include "Agumon_Turn_0.h"
+#include "Gabumon_Idle_0.h"
+#include "Gabumon_Idle_1.h"
+#include "Gabumon_Walk_0.h"
+#include "Gabumon_Walk_1.h"
+#include "Gabumon_Run_0.h"
+#include "Gabumon_Run_1.h"
+#include "Gabumon_Happy_0.h"
+#include "Gabumon_Rest_0.h"
+#include "Gabumon_Attack_0.h"
+#include "Gabumon_Turn_0.h"
+#include "Biyomon_Idle_0.h"
+#include "Biyomon_Idle_1.h"
+#include "Biyomon_Walk_0.h"
+#include "Biyomon_Walk_1.h"
+#include "Biyomon_Run_0.h"
+#include "Biyomon_Run_1.h"
+#include "Biyomon_Happy_0.h"
+#include "Biyomon_Rest_0.h"
+#include "Biyomon_Attack_0.h"
+#include "Biyomon_Turn_0.h"
+#include "Gatomon_Idle_0.h"
+#include "Gatomon_Idle_1.h"
+#include "Gatomon_Walk_0.h"
+#include "Gatomon_Walk_1.h"
+#include "Gatomon_Run_0.h"
+#include "Gatomon_Run_1.h"
+#include "Gatomon_Happy_0.h"
+#include "Gatomon_Rest_0.h"
+#include "Gatomon_Attack_0.h"
+#include "Gatomon_Turn_0.h"
+#include "Gomamon_Idle_0.h"
+#include "Gomamon_Idle_1.h"
+#include "Gomamon_Walk_0.h"
+#include "Gomamon_Walk_1.h"
+#include "Gomamon_Run_0.h"
+#include "Gomamon_Run_1.h"
+#include "Gomamon_Happy_0.h"
+#include "Gomamon_Rest_0.h"
+#include "Gomamon_Attack_0.h"
+#include "Gomamon_Turn_0.h"
+#include "Palmon_Idle_0.h"
+#include "Palmon_Idle_1.h"
+#include "Palmon_Walk_0.h"
+#include "Palmon_Walk_1.h"
+#include "Palmon_Run_0.h"
+#include "Palmon_Run_1.h"
+#include "Palmon_Happy_0.h"
+#include "Palmon_Rest_0.h"
+#include "Palmon_Attack_0.h"
+#include "Palmon_Turn_0.h"
+#include "Tentomon_Idle_0.h"
+#include "Tentomon_Idle_1.h"
+#include "Tentomon_Walk_0.h"
+#include "Tentomon_Walk_1.h"
+#include "Tentomon_Run_0.h"
+#include "Tentomon_Run_1.h"
+#include "Tentomon_Happy_0.h"
+#include "Tentomon_Rest_0.h"
+#include "Tentomon_Attack_0.h"
+#include "Tentomon_Turn_0.h"
+#include "Patamon_Idle_0.h"
+#include "Patamon_Idle_1.h"
+#include "Patamon_Walk_0.h"
+#include "Patamon_Walk_1.h"
+#include "Patamon_Run_0.h"
+#include "Patamon_Run_1.h"
+#include "Patamon_Happy_0.h"
+#include "Patamon_Rest_0.h"
+#include "Patamon_Attack_0.h"
+#include "Patamon_Turn_0.h"
+
+static const SpriteFrame kAgumonSprites[] = {
+    { AGUMON_IDLE_0_WIDTH, AGUMON_IDLE_0_HEIGHT, Agumon_Idle_0_data },
+    { AGUMON_IDLE_1_WIDTH, AGUMON_IDLE_1_HEIGHT, Agumon_Idle_1_data },
+    { AGUMON_WALK_0_WIDTH, AGUMON_WALK_0_HEIGHT, Agumon_Walk_0_data },
+    { AGUMON_WALK_1_WIDTH, AGUMON_WALK_1_HEIGHT, Agumon_Walk_1_data },
+    { AGUMON_RUN_0_WIDTH, AGUMON_RUN_0_HEIGHT, Agumon_Run_0_data },
+    { AGUMON_RUN_1_WIDTH, AGUMON_RUN_1_HEIGHT, Agumon_Run_1_data },
+    { AGUMON_HAPPY_0_WIDTH, AGUMON_HAPPY_0_HEIGHT, Agumon_Happy_0_data },
+    { AGUMON_REST_0_WIDTH, AGUMON_REST_0_HEIGHT, Agumon_Rest_0_data },
+    { AGUMON_ATTACK_0_WIDTH, AGUMON_ATTACK_0_HEIGHT, Agumon_Attack_0_data },
+    { AGUMON_TURN_0_WIDTH, AGUMON_TURN_0_HEIGHT, Agumon_Turn_0_data },
+};
+static const SpriteFrame kGabumonSprites[] = {
+    { GABUMON_IDLE_0_WIDTH, GABUMON_IDLE_0_HEIGHT, Gabumon_Idle_0_data },
+    { GABUMON_IDLE_1_WIDTH, GABUMON_IDLE_1_HEIGHT, Gabumon_Idle_1_data },
+    { GABUMON_WALK_0_WIDTH, GABUMON_WALK_0_HEIGHT, Gabumon_Walk_0_data },
+    { GABUMON_WALK_1_WIDTH, GABUMON_WALK_1_HEIGHT, Gabumon_Walk_1_data },
+    { GABUMON_RUN_0_WIDTH, GABUMON_RUN_0_HEIGHT, Gabumon_Run_0_data },
+    { GABUMON_RUN_1_WIDTH, GABUMON_RUN_1_HEIGHT, Gabumon_Run_1_data },
+    { GABUMON_HAPPY_0_WIDTH, GABUMON_HAPPY_0_HEIGHT, Gabumon_Happy_0_data },
+    { GABUMON_REST_0_WIDTH, GABUMON_REST_0_HEIGHT, Gabumon_Rest_0_data },
+    { GABUMON_ATTACK_0_WIDTH, GABUMON_ATTACK_0_HEIGHT, Gabumon_Attack_0_data },
+    { GABUMON_TURN_0_WIDTH, GABUMON_TURN_0_HEIGHT, Gabumon_Turn_0_data },
+};
+static const SpriteFrame kBiyomonSprites[] = {
+    { BIYOMON_IDLE_0_WIDTH, BIYOMON_IDLE_0_HEIGHT, Biyomon_Idle_0_data },
+    { BIYOMON_IDLE_1_WIDTH, BIYOMON_IDLE_1_HEIGHT, Biyomon_Idle_1_data },
+    { BIYOMON_WALK_0_WIDTH, BIYOMON_WALK_0_HEIGHT, Biyomon_Walk_0_data },
+    { BIYOMON_WALK_1_WIDTH, BIYOMON_WALK_1_HEIGHT, Biyomon_Walk_1_data },
+    { BIYOMON_RUN_0_WIDTH, BIYOMON_RUN_0_HEIGHT, Biyomon_Run_0_data },
+    { BIYOMON_RUN_1_WIDTH, BIYOMON_RUN_1_HEIGHT, Biyomon_Run_1_data },
+    { BIYOMON_HAPPY_0_WIDTH, BIYOMON_HAPPY_0_HEIGHT, Biyomon_Happy_0_data },
+    { BIYOMON_REST_0_WIDTH, BIYOMON_REST_0_HEIGHT, Biyomon_Rest_0_data },
+    { BIYOMON_ATTACK_0_WIDTH, BIYOMON_ATTACK_0_HEIGHT, Biyomon_Attack_0_data },
+    { BIYOMON_TURN_0_WIDTH, BIYOMON_TURN_0_HEIGHT, Biyomon_Turn_0_data },
+};
+static const SpriteFrame kGatomonSprites[] = {
+    { GATOMON_IDLE_0_WIDTH, GATOMON_IDLE_0_HEIGHT, Gatomon_Idle_0_data },
+    { GATOMON_IDLE_1_WIDTH, GATOMON_IDLE_1_HEIGHT, Gatomon_Idle_1_data },
+    { GATOMON_WALK_0_WIDTH, GATOMON_WALK_0_HEIGHT, Gatomon_Walk_0_data },
+    { GATOMON_WALK_1_WIDTH, GATOMON_WALK_1_HEIGHT, Gatomon_Walk_1_data },
+    { GATOMON_RUN_0_WIDTH, GATOMON_RUN_0_HEIGHT, Gatomon_Run_0_data },
+    { GATOMON_RUN_1_WIDTH, GATOMON_RUN_1_HEIGHT, Gatomon_Run_1_data },
+    { GATOMON_HAPPY_0_WIDTH, GATOMON_HAPPY_0_HEIGHT, Gatomon_Happy_0_data },
+    { GATOMON_REST_0_WIDTH, GATOMON_REST_0_HEIGHT, Gatomon_Rest_0_data },
+    { GATOMON_ATTACK_0_WIDTH, GATOMON_ATTACK_0_HEIGHT, Gatomon_Attack_0_data },
+    { GATOMON_TURN_0_WIDTH, GATOMON_TURN_0_HEIGHT, Gatomon_Turn_0_data },
+};
+static const SpriteFrame kGomamonSprites[] = {
+    { GOMAMON_IDLE_0_WIDTH, GOMAMON_IDLE_0_HEIGHT, Gomamon_Idle_0_data },
+    { GOMAMON_IDLE_1_WIDTH, GOMAMON_IDLE_1_HEIGHT, Gomamon_Idle_1_data },
+    { GOMAMON_WALK_0_WIDTH, GOMAMON_WALK_0_HEIGHT, Gomamon_Walk_0_data },
+    { GOMAMON_WALK_1_WIDTH, GOMAMON_WALK_1_HEIGHT, Gomamon_Walk_1_data },
+    { GOMAMON_RUN_0_WIDTH, GOMAMON_RUN_0_HEIGHT, Gomamon_Run_0_data },
+    { GOMAMON_RUN_1_WIDTH, GOMAMON_RUN_1_HEIGHT, Gomamon_Run_1_data },
+    { GOMAMON_HAPPY_0_WIDTH, GOMAMON_HAPPY_0_HEIGHT, Gomamon_Happy_0_data },
+    { GOMAMON_REST_0_WIDTH, GOMAMON_REST_0_HEIGHT, Gomamon_Rest_0_data },
+    { GOMAMON_ATTACK_0_WIDTH, GOMAMON_ATTACK_0_HEIGHT, Gomamon_Attack_0_data },
+    { GOMAMON_TURN_0_WIDTH, GOMAMON_TURN_0_HEIGHT, Gomamon_Turn_0_data },
+};
+static const SpriteFrame kPalmonSprites[] = {
+    { PALMON_IDLE_0_WIDTH, PALMON_IDLE_0_HEIGHT, Palmon_Idle_0_data },
+    { PALMON_IDLE_1_WIDTH, PALMON_IDLE_1_HEIGHT, Palmon_Idle_1_data },
+    { PALMON_WALK_0_WIDTH, PALMON_WALK_0_HEIGHT, Palmon_Walk_0_data },
+    { PALMON_WALK_1_WIDTH, PALMON_WALK_1_HEIGHT, Palmon_Walk_1_data },
+    { PALMON_RUN_0_WIDTH, PALMON_RUN_0_HEIGHT, Palmon_Run_0_data },
+    { PALMON_RUN_1_WIDTH, PALMON_RUN_1_HEIGHT, Palmon_Run_1_data },
+    { PALMON_HAPPY_0_WIDTH, PALMON_HAPPY_0_HEIGHT, Palmon_Happy_0_data },
+    { PALMON_REST_0_WIDTH, PALMON_REST_0_HEIGHT, Palmon_Rest_0_data },
+    { PALMON_ATTACK_0_WIDTH, PALMON_ATTACK_0_HEIGHT, Palmon_Attack_0_data },
+    { PALMON_TURN_0_WIDTH, PALMON_TURN_0_HEIGHT, Palmon_Turn_0_data },
+};
+static const SpriteFrame kTentomonSprites[] = {
+    { TENTOMON_IDLE_0_WIDTH, TENTOMON_IDLE_0_HEIGHT, Tentomon_Idle_0_data },
+    { TENTOMON_IDLE_1_WIDTH, TENTOMON_IDLE_1_HEIGHT, Tentomon_Idle_1_data },
+    { TENTOMON_WALK_0_WIDTH, TENTOMON_WALK_0_HEIGHT, Tentomon_Walk_0_data },
+    { TENTOMON_WALK_1_WIDTH, TENTOMON_WALK_1_HEIGHT, Tentomon_Walk_1_data },
+    { TENTOMON_RUN_0_WIDTH, TENTOMON_RUN_0_HEIGHT, Tentomon_Run_0_data },
+    { TENTOMON_RUN_1_WIDTH, TENTOMON_RUN_1_HEIGHT, Tentomon_Run_1_data },
+    { TENTOMON_HAPPY_0_WIDTH, TENTOMON_HAPPY_0_HEIGHT, Tentomon_Happy_0_data },
+    { TENTOMON_REST_0_WIDTH, TENTOMON_REST_0_HEIGHT, Tentomon_Rest_0_data },
+    { TENTOMON_ATTACK_0_WIDTH, TENTOMON_ATTACK_0_HEIGHT, Tentomon_Attack_0_data },
+    { TENTOMON_TURN_0_WIDTH, TENTOMON_TURN_0_HEIGHT, Tentomon_Turn_0_data },
+};
+static const SpriteFrame kPatamonSprites[] = {
+    { PATAMON_IDLE_0_WIDTH, PATAMON_IDLE_0_HEIGHT, Patamon_Idle_0_data },
+    { PATAMON_IDLE_1_WIDTH, PATAMON_IDLE_1_HEIGHT, Patamon_Idle_1_data },
+    { PATAMON_WALK_0_WIDTH, PATAMON_WALK_0_HEIGHT, Patamon_Walk_0_data },
+    { PATAMON_WALK_1_WIDTH, PATAMON_WALK_1_HEIGHT, Patamon_Walk_1_data },
+    { PATAMON_RUN_0_WIDTH, PATAMON_RUN_0_HEIGHT, Patamon_Run_0_data },
+    { PATAMON_RUN_1_WIDTH, PATAMON_RUN_1_HEIGHT, Patamon_Run_1_data },
+    { PATAMON_HAPPY_0_WIDTH, PATAMON_HAPPY_0_HEIGHT, Patamon_Happy_0_data },
+    { PATAMON_REST_0_WIDTH, PATAMON_REST_0_HEIGHT, Patamon_Rest_0_data },
+    { PATAMON_ATTACK_0_WIDTH, PATAMON_ATTACK_0_HEIGHT, Patamon_Attack_0_data },
+    { PATAMON_TURN_0_WIDTH, PATAMON_TURN_0_HEIGHT, Patamon_Turn_0_data },
+};
+
+const DigimonDef kDigimonRoster[DIGI_COUNT] = {
+    { "Agumon", kAgumonSprites, 10 },
+    { "Gabumon", kGabumonSprites, 10 },
+    { "Biyomon", kBiyomonSprites, 10 },
+    { "Gatomon", kGatomonSprites, 10 },
+    { "Gomamon", kGomamonSprites, 10 },
+    { "Palmon", kPalmonSprites, 10 },
+    { "Tentomon", kTentomonSprites, 10 },
+    { "Patamon", kPatamonSprites, 10 },
+};
+
+#endif // ANIMATION_MANIFEST_DATA_H
@@ -0,0 +1,144 @@
+// Benchmark: painter's-algorithm replay vs the scanline compositor on the same recorded frames.
+// Scenes: the game's three parallax layers plus one sprite, and the same with a crowd.
+// Both paths render into a HeadlessDisplay; the outputs are compared pixel for pixel.
+// Usage: bench_compositor [frames]
+#include "CrowdRenderer.h"
+#include "EntityStore.h"
+#include "Blitter.h"
+#include "RenderCounters.h"
+#include "ScanlineCompositor.h"
+#include "platform/DrawList.h"
+#include "platform/headless/HeadlessDisplay.h"
+#include "castlebackground0.h"
+#include "castlebackground1.h"
+#include "castlebackground2.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const int kScreen = 466;
+static const int kEffectiveBgWidth = 947;
+
+// Mirrors Game::render: layer 2, layer 1, characters, layer 0, each background drawn twice to wrap
+static void recordScene(DrawList& list, int frame, const CrowdRenderer* crowd, const SpriteFrame& hero) {
+    struct Layer { const uint16_t* data; int width, height; float speed; uint8_t layer; };
+    static const Layer backgrounds[] = {
+        {castlebackground2_data, CASTLEBACKGROUND2_WIDTH, CASTLEBACKGROUND2_HEIGHT, 0.5f, 0},
+        {castlebackground1_data, CASTLEBACKGROUND1_WIDTH, CASTLEBACKGROUND1_HEIGHT, 1.0f, 1},
+        {castlebackground0_data, CASTLEBACKGROUND0_WIDTH, CASTLEBACKGROUND0_HEIGHT, 3.0f, 3},
+    };
+    static uint8_t flags[3] = {0, 0, 0}; // As Game: DRAW_OPAQUE for tiles without transparent pixels
+    if (!flags[0]) {
+        for (int i = 0; i < 3; ++i) {
+            flags[i] = isOpaque(backgrounds[i].data, static_cast<long>(backgrounds[i].width) * backgrounds[i].height) ? DRAW_OPAQUE : DRAW_COLOR_KEY;
+        }
+    }
+    list.reset();
+    list.setClip(0, 0, kScreen, kScreen);
+    list.clear(0x0000);
+    for (int i = 0; i < 3; ++i) {
+        const Layer& bg = backgrounds[i];
+        int x = -(static_cast<int>(frame * bg.speed) % kEffectiveBgWidth);
+        list.blit(bg.layer, x, 0, bg.width, bg.height, bg.data, bg.width, bg.height, 0, 0, flags[i]);
+        list.blit(bg.layer, x + kEffectiveBgWidth, 0, bg.width, bg.height, bg.data, bg.width, bg.height, 0, 0, flags[i]);
+    }
+    if (crowd) {
+        crowd->record(list, 2);
+    } else {
+        list.blit(2, (kScreen - hero.width) / 2, (kScreen - hero.height) / 2, hero.width, hero.height,
+                  hero.data, hero.width, hero.height, 0, 0);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int frames = (argc > 1) ? std::atoi(argv[1]) : 120;
+    const size_t crowd_sizes[] = {0, 10, 100, 1000};
+
+    HeadlessDisplay painter, scanline;
+    if (!painter.init("painter", kScreen, kScreen) || !scanline.init("scanline", kScreen, kScreen)) return 1;
+    // As Game: the scanline path keeps the backgrounds converted in ring caches
+    scanline.cacheLayer(castlebackground0_data, CASTLEBACKGROUND0_WIDTH, CASTLEBACKGROUND0_HEIGHT, kEffectiveBgWidth);
+    scanline.cacheLayer(castlebackground1_data, CASTLEBACKGROUND1_WIDTH, CASTLEBACKGROUND1_HEIGHT, kEffectiveBgWidth);
+    scanline.cacheLayer(castlebackground2_data, CASTLEBACKGROUND2_WIDTH, CASTLEBACKGROUND2_HEIGHT, kEffectiveBgWidth);
+
+    const SpriteFrame* sprites[DIGI_COUNT];
+    for (int d = 0; d < DIGI_COUNT; ++d) sprites[d] = kDigimonRoster[d].sprites;
+    const SpriteFrame& hero = kDigimonRoster[DIGI_AGUMON].sprites[0];
+
+    std::printf("%d frames per scene, %dx%d\n", frames, kScreen, kScreen);
+    std::printf("%-14s %12s %12s %9s %14s %14s %10s\n", "scene", "painter ms", "scanline ms", "speedup",
+                "painter lay/px", "touched lay/px", "identical");
+
+    for (size_t crowd_size : crowd_sizes) {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> pick_digimon(0, DIGI_COUNT - 1);
+        std::uniform_real_distribution<float> pick_x(0.0f, kScreen + 192.0f);
+        std::uniform_real_distribution<float> pick_y(kScreen / 2.0f, kScreen + 60.0f);
+
+        EntityStore store;
+        CrowdRenderer crowd;
+        crowd.setViewport(kScreen, kScreen);
+        crowd.setCameraX(96);
+        for (size_t i = 0; i < crowd_size; ++i) {
+            store.create(static_cast<DigimonType>(pick_digimon(rng)), ACTION_WALK, pick_x(rng), pick_y(rng), 1.0f, 0, true);
+        }
+
+        DrawList list(crowd_size + 16);
+        using clock = std::chrono::steady_clock;
+        double painter_ms = 0.0, scanline_ms = 0.0, painter_layers = 0.0, touched_layers = 0.0;
+        uint64_t columns_converted = 0;
+        bool identical = true;
+        for (int frame = 0; frame < frames; ++frame) {
+            store.updateAnimations(static_cast<uint32_t>(frame) * 16);
+            store.updateMovement(1.0f, kScreen + 192.0f);
+            crowd.prepare(store, sprites);
+
+            recordScene(list, frame, crowd_size ? &crowd : nullptr, hero);
+            clock::time_point t0 = clock::now();
+            replayDrawList(painter, list);
+            clock::time_point t1 = clock::now();
+
+            recordScene(list, frame, crowd_size ? &crowd : nullptr, hero);
+            clock::time_point t2 = clock::now();
+            scanline.submit(list);
+            clock::time_point t3 = clock::now();
+
+            painter_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+            scanline_ms += std::chrono::duration<double, std::milli>(t3 - t2).count();
+            painter_layers += scanline.compositorStats()->painterLayersPerPixel();
+            touched_layers += scanline.compositorStats()->layersTouchedPerPixel();
+            columns_converted += scanline.compositorStats()->columns_converted;
+            identical = identical && std::memcmp(painter.pixels(), scanline.pixels(), sizeof(uint32_t) * kScreen * kScreen) == 0;
+            painter.present(); // Closes each display's RenderCounters frame
+            scanline.present();
+        }
+
+        char name[32];
+        std::snprintf(name, sizeof(name), crowd_size ? "bg+%zu sprites" : "bg+hero", crowd_size);
+        std::printf("%-14s %12.3f %12.3f %8.2fx %14.2f %14.2f %10s\n", name, painter_ms / frames, scanline_ms / frames,
+                    painter_ms / scanline_ms, painter_layers / frames, touched_layers / frames, identical ? "yes" : "NO");
+
+        // Coverage report of the last frame
+        const CompositorStats& stats = *scanline.compositorStats();
+        std::printf("  coverage: far %.1f%%  mid %.1f%%  characters %.1f%%  fore %.1f%%  cleared %.1f%%  hidden %.2f px/px  culled %u blits\n",
+                    stats.coverage(stats.layer_written[0]), stats.coverage(stats.layer_written[1]),
+                    stats.coverage(stats.layer_written[2]), stats.coverage(stats.layer_written[3]),
+                    stats.coverage(stats.pixels_cleared), static_cast<double>(stats.pixels_hidden) / stats.pixels,
+                    stats.blits_culled);
+        // Traffic of the last frame (painter stores count every visited pixel of keyed blits)
+        const RenderCounters& painter_traffic = *painter.renderCounters();
+        const RenderCounters& scanline_traffic = *scanline.renderCounters();
+        std::printf("  background columns converted: %llu over %d frames (%.1f per frame)\n",
+                    static_cast<unsigned long long>(columns_converted), frames, static_cast<double>(columns_converted) / frames);
+        std::printf("  traffic: painter read %.2f px/px written %.2f px/px, scanline read %.2f px/px written %.2f px/px\n",
+                    static_cast<double>(painter_traffic.totalRead()) / stats.pixels,
+                    static_cast<double>(painter_traffic.totalWritten()) / stats.pixels,
+                    static_cast<double>(scanline_traffic.totalRead()) / stats.pixels,
+                    static_cast<double>(scanline_traffic.totalWritten()) / stats.pixels);
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Benchmark: crowd mode (update kernels + cull/y-sort + recorded sprite drawing) on the 466x466 target.
+// Renders into a HeadlessDisplay so only the CPU side of the frame is measured.
+// Usage: bench_crowd [frames]
+#include "CrowdRenderer.h"
+#include "EntityStore.h"
+#include "platform/DrawList.h"
+#include "platform/headless/HeadlessDisplay.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char* argv[]) {
+    const int frames = (argc > 1) ? std::atoi(argv[1]) : 120;
+    const int screen_size = 466;
+    const int margin = 96; // Half a sprite either side, as in Game
+    const float world_width = static_cast<float>(screen_size + 2 * margin);
+    const uint32_t frame_ms = 16;
+    const double frame_budget_ms = 1000.0 / 60.0;
+    const size_t crowd_sizes[] = {10, 100, 1000, 10000};
+
+    HeadlessDisplay display;
+    if (!display.init("bench_crowd", screen_size, screen_size)) return 1;
+
+    // Every character's compiled-in frames stand in for resident assets
+    const SpriteFrame* sprites[DIGI_COUNT];
+    for (int d = 0; d < DIGI_COUNT; ++d) sprites[d] = kDigimonRoster[d].sprites;
+
+    CrowdRenderer renderer;
+    renderer.setViewport(screen_size, screen_size);
+    renderer.setCameraX(margin);
+
+    std::printf("%d frames per size, %dx%d, 60 FPS budget %.2f ms\n", frames, screen_size, screen_size, frame_budget_ms);
+    // "switches": draws whose source frame differs from the previous draw, after grouping by
+    // frame; "y-order" is the same count for the plain back-to-front order
+    std::printf("%8s %10s %10s %10s %10s %12s %10s %14s\n",
+                "sprites", "visible", "y-order", "switches", "ms/frame", "ns/sprite", "fps", "sprites@60fps");
+
+    for (size_t count : crowd_sizes) {
+        std::mt19937 rng(1234); // Fixed seed so runs are comparable
+        std::uniform_int_distribution<int> pick_digimon(0, DIGI_COUNT - 1);
+        std::uniform_real_distribution<float> pick_x(0.0f, world_width);
+        std::uniform_real_distribution<float> pick_y(screen_size / 2.0f, screen_size + 60.0f);
+        std::uniform_real_distribution<float> pick_speed(0.5f, 1.5f);
+        std::uniform_int_distribution<uint32_t> pick_phase(0, 1000);
+
+        DrawList list(count);
+        EntityStore store;
+        store.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            DigimonType digimon = static_cast<DigimonType>(pick_digimon(rng));
+            bool walking = (i % 2) != 0;
+            store.create(digimon, walking ? ACTION_WALK : ACTION_IDLE, pick_x(rng), pick_y(rng),
+                         walking ? pick_speed(rng) : 0.0f, 0u - pick_phase(rng), walking);
+        }
+
+        using clock = std::chrono::steady_clock;
+        uint32_t now_ms = 0;
+        long long visible_total = 0, sorted_switches_total = 0, switches_total = 0;
+        clock::time_point start = clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            now_ms += frame_ms;
+            store.updateAnimations(now_ms);
+            store.updateMovement(1.0f, world_width);
+            renderer.prepare(store, sprites);
+
+            list.reset();
+            list.clear(0x0000);
+            renderer.record(list, 0);
+            display.submit(list);
+            display.present();
+
+            visible_total += renderer.visibleCount();
+            sorted_switches_total += renderer.sortedFrameSwitchCount();
+            switches_total += renderer.frameSwitchCount();
+        }
+        double total_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        double ms_per_frame = total_ms / frames;
+        double sprites_at_60 = static_cast<double>(count) * frame_budget_ms / ms_per_frame;
+        std::printf("%8zu %10lld %10lld %10lld %10.3f %12.1f %10.1f %14.0f\n",
+                    count, visible_total / frames, sorted_switches_total / frames, switches_total / frames, ms_per_frame,
+                    ms_per_frame * 1e6 / static_cast<double>(count), 1000.0 / ms_per_frame, sprites_at_60);
+    }
+    // Hash the last frame so the drawing can't be optimised away (and regressions show up)
+    uint32_t hash = 2166136261u;
+    size_t covered = 0;
+    for (int i = 0; i < screen_size * screen_size; ++i) {
+        hash = (hash ^ display.pixels()[i]) * 16777619u;
+        covered += display.pixels()[i] != 0xFF000000u;
+    }
+    std::printf("(last frame hash %08x, %zu non-black pixels)\n", static_cast<unsigned>(hash), covered);
+    return 0;
+}
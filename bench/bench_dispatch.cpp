@@ -0,0 +1,73 @@
+// Benchmark: virtual vs statically bound drawCommand when replaying a frame's draw list.
+// "virtual" replays through IDisplay::submit (one virtual drawCommand per blit), the fallback
+// for backends without their own submit; "static" is the same replay instantiated for the
+// final HeadlessDisplay (replayDrawList<HeadlessDisplay>), so each drawCommand is bound
+// statically. Both do the same blits: HeadlessDisplay::submit (the compositor) isn't timed.
+// Expect about 1.0x: a call per blit is noise next to the blit, even at 4x4. Every backend
+// in this tree overrides submit() anyway, so neither path is on a frame's hot path, and
+// DIGIVICE_STATIC_PLATFORM doesn't change that (see include/platform/Platform.h).
+// Usage: bench_dispatch [frames]
+#include "platform/DrawList.h"
+#include "platform/headless/HeadlessDisplay.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct Workload {
+    const char* name;
+    int blit_size; // Square blits tiling the screen
+};
+
+int main(int argc, char* argv[]) {
+    const int frames = (argc > 1) ? std::atoi(argv[1]) : 200;
+    const int screen_size = 466;
+    const Workload workloads[] = {{"4x4 tiles", 4}, {"8x8 tiles", 8}, {"16x16 tiles", 16}, {"64x64 tiles", 64}};
+
+    HeadlessDisplay display;
+    if (!display.init("bench_dispatch", screen_size, screen_size)) return 1;
+    IDisplay& base = display;
+
+    // Opaque gradient source (no colour-key pixels)
+    std::vector<uint16_t> source(64 * 64);
+    for (size_t i = 0; i < source.size(); ++i) source[i] = static_cast<uint16_t>(i * 37) & 0x7BEF;
+
+    std::printf("%d frames per workload, %dx%d\n", frames, screen_size, screen_size);
+    std::printf("%-12s %8s %14s %14s %10s\n", "workload", "blits", "virtual ns/blit", "static ns/blit", "speedup");
+
+    for (const Workload& w : workloads) {
+        const int per_row = (screen_size + w.blit_size - 1) / w.blit_size;
+        DrawList list(static_cast<size_t>(per_row) * per_row);
+        auto record = [&]() {
+            list.reset();
+            for (int y = 0; y < per_row; ++y) {
+                for (int x = 0; x < per_row; ++x) {
+                    list.blit(0, x * w.blit_size, y * w.blit_size, w.blit_size, w.blit_size,
+                              source.data(), 64, 64, 0, 0);
+                }
+            }
+        };
+
+        using clock = std::chrono::steady_clock;
+        double virtual_ns = 0.0, static_ns = 0.0;
+        for (int frame = 0; frame < frames; ++frame) {
+            record();
+            clock::time_point t0 = clock::now();
+            base.IDisplay::submit(list); // Base replay: drawCommand through the vtable
+            clock::time_point t1 = clock::now();
+            record();
+            clock::time_point t2 = clock::now();
+            replayDrawList(display, list); // HeadlessDisplay is final: drawCommand bound statically
+            clock::time_point t3 = clock::now();
+            virtual_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            static_ns += std::chrono::duration<double, std::nano>(t3 - t2).count();
+        }
+
+        const double blits = static_cast<double>(list.size()) * frames;
+        std::printf("%-12s %8zu %14.1f %14.1f %9.2fx\n", w.name, list.size(),
+                    virtual_ns / blits, static_ns / blits, virtual_ns / static_ns);
+    }
+    std::printf("(pixel %08x)\n", static_cast<unsigned>(display.pixels()[screen_size * screen_size / 2]));
+    return 0;
+}
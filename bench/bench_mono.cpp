@@ -0,0 +1,118 @@
+// Benchmark: the 1bpp dot-matrix LCD path (MonoRenderer) against the RGB565 scanline compositor.
+// Same recorded frames as the game (three scrolling parallax layers and a crowd); the mono
+// renderer draws them at full resolution and at the LCD's 1/2 and 1/4 resolutions.
+// Plane derivation happens on first use, so it is timed separately from the frames.
+// Usage: bench_mono [frames] [crowd size]
+#include "CrowdRenderer.h"
+#include "EntityStore.h"
+#include "Blitter.h"
+#include "MonoRenderer.h"
+#include "ScanlineCompositor.h"
+#include "platform/DrawList.h"
+#include "castlebackground0.h"
+#include "castlebackground1.h"
+#include "castlebackground2.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int kScreen = 466;
+static const int kEffectiveBgWidth = 947;
+
+struct Background { const uint16_t* data; int width, height; float speed; uint8_t layer; };
+static const Background kBackgrounds[] = {
+    {castlebackground2_data, CASTLEBACKGROUND2_WIDTH, CASTLEBACKGROUND2_HEIGHT, 0.5f, 0},
+    {castlebackground1_data, CASTLEBACKGROUND1_WIDTH, CASTLEBACKGROUND1_HEIGHT, 1.0f, 1},
+    {castlebackground0_data, CASTLEBACKGROUND0_WIDTH, CASTLEBACKGROUND0_HEIGHT, 3.0f, 3},
+};
+
+static void recordScene(DrawList& list, int frame, const CrowdRenderer& crowd) {
+    list.reset();
+    list.setClip(0, 0, kScreen, kScreen);
+    list.clear(0x0000);
+    for (const Background& bg : kBackgrounds) {
+        uint8_t flags = isOpaque(bg.data, static_cast<long>(bg.width) * bg.height) ? DRAW_OPAQUE : DRAW_COLOR_KEY;
+        for (int x = -(static_cast<int>(frame * bg.speed) % kEffectiveBgWidth); x < kScreen; x += kEffectiveBgWidth) {
+            list.blit(bg.layer, x, 0, kEffectiveBgWidth, bg.height, bg.data, bg.width, bg.height, 0, 0, flags);
+        }
+    }
+    crowd.record(list, 2);
+}
+
+int main(int argc, char* argv[]) {
+    const int frames = (argc > 1) ? std::atoi(argv[1]) : 240;
+    const size_t crowd_size = (argc > 2) ? static_cast<size_t>(std::atoi(argv[2])) : 10;
+    if (frames < 1) return 1;
+
+    const SpriteFrame* sprites[DIGI_COUNT];
+    for (int d = 0; d < DIGI_COUNT; ++d) sprites[d] = kDigimonRoster[d].sprites;
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> pick_digimon(0, DIGI_COUNT - 1);
+    std::uniform_real_distribution<float> pick_x(0.0f, kScreen + 192.0f);
+    std::uniform_real_distribution<float> pick_y(kScreen / 2.0f, kScreen + 60.0f);
+    EntityStore store;
+    CrowdRenderer crowd;
+    crowd.setViewport(kScreen, kScreen);
+    crowd.setCameraX(96);
+    for (size_t i = 0; i < crowd_size; ++i) {
+        store.create(static_cast<DigimonType>(pick_digimon(rng)), ACTION_WALK, pick_x(rng), pick_y(rng), 1.0f, 0, true);
+    }
+
+    // Record every frame once up front, so each renderer times only its own work
+    std::vector<DrawList> lists;
+    lists.reserve(frames);
+    for (int frame = 0; frame < frames; ++frame) {
+        store.updateAnimations(static_cast<uint32_t>(frame) * 16);
+        store.updateMovement(1.0f, kScreen + 192.0f);
+        crowd.prepare(store, sprites);
+        lists.emplace_back(crowd_size + 16);
+        recordScene(lists.back(), frame, crowd);
+    }
+    using clock = std::chrono::steady_clock;
+
+    std::printf("%d frames, %dx%d logical, %zu sprites, %d-dot words\n", frames, kScreen, kScreen, crowd_size, MONO_WORD_BITS);
+    std::printf("%-24s %10s %12s %12s %14s %12s\n", "path", "dots", "frame bytes", "ms/frame", "vs RGB565", "warm-up ms");
+
+    // RGB565 reference: the scanline compositor into a full framebuffer
+    ScanlineCompositor compositor;
+    std::vector<uint16_t> rgb(static_cast<size_t>(kScreen) * kScreen);
+    BlitSurface target = {rgb.data(), kScreen, kScreen, kScreen, PixelFormat::RGB565};
+    std::vector<DrawList> replay = lists;
+    clock::time_point t0 = clock::now();
+    compositor.compose(replay[0], target); // Builds the span tables
+    double rgb_warmup_ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+    t0 = clock::now();
+    for (int frame = 1; frame < frames; ++frame) compositor.compose(replay[frame], target);
+    double rgb_ms = frames > 1 ? std::chrono::duration<double, std::milli>(clock::now() - t0).count() / (frames - 1) : 0.0;
+    std::printf("%-24s %10d %12zu %12.4f %14s %12.2f\n", "RGB565 scanline", kScreen * kScreen, rgb.size() * sizeof(uint16_t),
+                rgb_ms, "1x", rgb_warmup_ms);
+
+    for (int downscale : {1, 2, 4}) {
+        MonoRenderer mono(downscale);
+        mono.init(kScreen, kScreen);
+        replay = lists;
+        t0 = clock::now();
+        mono.submit(replay[0]); // Derives the bit planes
+        double warmup_ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+        t0 = clock::now();
+        for (int frame = 1; frame < frames; ++frame) mono.submit(replay[frame]);
+        double ms = frames > 1 ? std::chrono::duration<double, std::milli>(clock::now() - t0).count() / (frames - 1) : 0.0;
+
+        int inked = 0;
+        for (int y = 0; y < mono.height(); ++y) {
+            for (int x = 0; x < mono.width(); ++x) inked += mono.dot(x, y);
+        }
+        char name[48], speedup[32];
+        std::snprintf(name, sizeof(name), "1bpp %dx%d (1/%d)", mono.width(), mono.height(), downscale);
+        std::snprintf(speedup, sizeof(speedup), "%.0fx faster", ms > 0.0 ? rgb_ms / ms : 0.0);
+        std::printf("%-24s %10d %12zu %12.4f %14s %12.2f\n", name, mono.width() * mono.height(),
+                    static_cast<size_t>(mono.wordsPerRow()) * mono.height() * sizeof(MonoWord), ms, speedup, warmup_ms);
+        std::printf("  %.1f%% of dots inked, %.1f words written per frame, planes %.1f KB\n",
+                    100.0 * inked / (mono.width() * mono.height()),
+                    static_cast<double>(mono.wordsWritten()) / frames, mono.planeBytes() / 1024.0);
+    }
+    return 0;
+}
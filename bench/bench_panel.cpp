@@ -0,0 +1,120 @@
+// Benchmark: bus traffic of the flush strategies on a simulated SPI/QSPI panel (PanelDisplay).
+// The frames follow the game: a walk (all three parallax layers scrolling, so everything is
+// damaged), then the hero idling in front of a still background (only the frame-to-frame
+// change baked into the manifest is damaged, nothing on frames where the sprite holds).
+// Each strategy drives the panel for real once; the panel RAM is checked against the same
+// frames composited whole, and the sent traffic against the strategy's estimate.
+// Usage: bench_panel [walk frames] [idle frames]
+#include "Blitter.h"
+#include "DigimonRoster.h"
+#include "ScanlineCompositor.h"
+#include "platform/DrawList.h"
+#include "platform/headless/PanelDisplay.h"
+#include "castlebackground0.h"
+#include "castlebackground1.h"
+#include "castlebackground2.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static const int kScreen = 466;
+static const int kEffectiveBgWidth = 947;
+
+struct Background { const uint16_t* data; int width, height; float speed; uint8_t layer; };
+static const Background kBackgrounds[] = {
+    {castlebackground2_data, CASTLEBACKGROUND2_WIDTH, CASTLEBACKGROUND2_HEIGHT, 0.5f, 0},
+    {castlebackground1_data, CASTLEBACKGROUND1_WIDTH, CASTLEBACKGROUND1_HEIGHT, 1.0f, 1},
+    {castlebackground0_data, CASTLEBACKGROUND0_WIDTH, CASTLEBACKGROUND0_HEIGHT, 3.0f, 3},
+};
+
+// As Game::render: backgrounds one period wide, the hero centred on layer 2. The damage rect
+// is what Game::recordDamage would report.
+static void recordFrame(DrawList& list, int frame, int walk_frames, const Animation& idle) {
+    const bool walking = frame < walk_frames;
+    const int scroll_frame = walking ? frame : walk_frames;
+    list.reset();
+    list.setClip(0, 0, kScreen, kScreen);
+    list.clear(0x0000);
+    for (const Background& bg : kBackgrounds) {
+        uint8_t flags = isOpaque(bg.data, static_cast<long>(bg.width) * bg.height) ? DRAW_OPAQUE : DRAW_COLOR_KEY;
+        for (int x = -(static_cast<int>(scroll_frame * bg.speed) % kEffectiveBgWidth); x < kScreen; x += kEffectiveBgWidth) {
+            list.blit(bg.layer, x, 0, kEffectiveBgWidth, bg.height, bg.data, bg.width, bg.height, 0, 0, flags);
+        }
+    }
+
+    const int idle_ms = (frame - walk_frames) * 16;
+    const int shown = walking ? 0 : sampleAnimation(idle, static_cast<uint32_t>(idle_ms)).frame;
+    const SpriteFrame& hero = idle.frame(shown);
+    const int hero_x = (kScreen - hero.width) / 2, hero_y = (kScreen - hero.height) / 2;
+    list.blit(2, hero_x, hero_y, hero.width, hero.height, hero.data, hero.width, hero.height, 0, 0);
+
+    if (walking || frame == walk_frames) return; // Whole frame damaged
+    const int previous = sampleAnimation(idle, static_cast<uint32_t>(idle_ms - 16)).frame;
+    if (previous == shown) {
+        list.setDamage(0, 0, 0, 0);
+    } else if (previous == idle.previousFrame(shown)) {
+        const AnimFrameDiff& diff = idle.frame_diffs[shown];
+        list.setDamage(hero_x + diff.x, hero_y + diff.y, diff.w, diff.h);
+    } else {
+        list.setDamage(hero_x, hero_y, hero.width, hero.height);
+    }
+}
+
+static void report(const char* bus_name, const SpiBusConfig& bus, int walk_frames, int idle_frames) {
+    const Animation idle = animationFor(DIGI_AGUMON, ACTION_IDLE, kDigimonRoster[DIGI_AGUMON].sprites);
+    const int frames = walk_frames + idle_frames;
+    std::printf("\n%s: %.0f MHz, %d command / %d data lanes, %.1f us per transaction, window alignment %d\n",
+                bus_name, bus.clock_hz / 1e6, bus.command_lanes, bus.data_lanes, bus.transaction_overhead_s * 1e6,
+                bus.window_align);
+    std::printf("%-12s %12s %14s %12s %10s %10s %10s %10s\n", "strategy", "KB/frame", "transfers/frame",
+                "bus ms/frame", "max fps", "walk fps", "idle fps", "panel ok");
+
+    for (int s = 0; s < FLUSH_STRATEGY_COUNT; ++s) {
+        const FlushStrategy strategy = static_cast<FlushStrategy>(s);
+        PanelDisplay display(bus, strategy);
+        display.init("panel", kScreen, kScreen);
+        ScanlineCompositor reference;
+        std::vector<uint16_t> expected(static_cast<size_t>(kScreen) * kScreen);
+        BlitSurface expected_surface = {expected.data(), kScreen, kScreen, kScreen, PixelFormat::RGB565};
+
+        DrawList list(16);
+        bool identical = true;
+        PanelTraffic walk = {};
+        for (int frame = 0; frame < frames; ++frame) {
+            recordFrame(list, frame, walk_frames, idle);
+            display.submit(list);
+            display.present();
+            if (frame + 1 == walk_frames) walk = display.estimate(strategy);
+
+            recordFrame(list, frame, walk_frames, idle);
+            list.setDamage(0, 0, kScreen, kScreen);
+            reference.compose(list, expected_surface);
+            identical = identical && std::memcmp(display.panel()->gram(), expected.data(), expected.size() * sizeof(uint16_t)) == 0;
+        }
+
+        // What was sent must be exactly what the strategy's estimate priced
+        const PanelTraffic& sent = display.panel()->traffic();
+        const PanelTraffic& estimate = display.estimate(strategy);
+        const bool priced = sent.bytes == estimate.bytes && sent.transactions == estimate.transactions;
+        const double idle_seconds = estimate.bus_seconds - walk.bus_seconds;
+        std::printf("%-12s %12.1f %14.1f %12.3f %10.1f %10.1f %10.1f %10s\n", flushStrategyName(strategy),
+                    estimate.bytes / 1024.0 / frames, static_cast<double>(estimate.transactions) / frames,
+                    estimate.bus_seconds * 1000.0 / frames, display.maxFps(strategy),
+                    walk.bus_seconds > 0.0 ? walk_frames / walk.bus_seconds : 0.0,
+                    idle_seconds > 0.0 ? idle_frames / idle_seconds : 0.0,
+                    identical && priced ? "yes" : (identical ? "MISPRICED" : "NO"));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int walk_frames = (argc > 1) ? std::atoi(argv[1]) : 120;
+    const int idle_frames = (argc > 2) ? std::atoi(argv[2]) : 360;
+    if (walk_frames < 1 || idle_frames < 1) return 1;
+
+    std::printf("%dx%d RGB565, %d walking + %d idle frames, 16-row strips\n", kScreen, kScreen, walk_frames, idle_frames);
+    report("SPI", SpiBusConfig::spi(40e6), walk_frames, idle_frames);
+    report("QSPI", SpiBusConfig::qspi(80e6), walk_frames, idle_frames);
+    return 0;
+}
@@ -0,0 +1,171 @@
+// Benchmark: compositing on a RenderThread against compositing inline on the game thread,
+// when presenting a frame is slow (vsync or a panel transfer, modelled as a fixed wait).
+// The game thread ticks at 60 Hz: it advances a crowd and records the frame, then either
+// composites and presents it itself, or submits a snapshot and carries on. Reports the tick
+// rate the game thread kept, its own time per tick, the frames shown per second, snapshots
+// the renderer skipped, and latency from a tick's start to its frame being presented.
+// Usage: bench_render_thread [frames] [present ms] [crowd size]
+#include "CrowdRenderer.h"
+#include "EntityStore.h"
+#include "Blitter.h"
+#include "RenderThread.h"
+#include "ScanlineCompositor.h"
+#include "platform/DrawList.h"
+#include "castlebackground0.h"
+#include "castlebackground1.h"
+#include "castlebackground2.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+static const int kScreen = 466;
+static const int kEffectiveBgWidth = 947;
+static const int kTickMs = 16;
+
+struct Background { const uint16_t* data; int width, height; float speed; uint8_t layer; };
+static const Background kBackgrounds[] = {
+    {castlebackground2_data, CASTLEBACKGROUND2_WIDTH, CASTLEBACKGROUND2_HEIGHT, 0.5f, 0},
+    {castlebackground1_data, CASTLEBACKGROUND1_WIDTH, CASTLEBACKGROUND1_HEIGHT, 1.0f, 1},
+    {castlebackground0_data, CASTLEBACKGROUND0_WIDTH, CASTLEBACKGROUND0_HEIGHT, 3.0f, 3},
+};
+
+static void recordScene(DrawList& list, int frame, const CrowdRenderer& crowd) {
+    list.reset();
+    list.setClip(0, 0, kScreen, kScreen);
+    list.clear(0x0000);
+    for (const Background& bg : kBackgrounds) {
+        uint8_t flags = isOpaque(bg.data, static_cast<long>(bg.width) * bg.height) ? DRAW_OPAQUE : DRAW_COLOR_KEY;
+        for (int x = -(static_cast<int>(frame * bg.speed) % kEffectiveBgWidth); x < kScreen; x += kEffectiveBgWidth) {
+            list.blit(bg.layer, x, 0, kEffectiveBgWidth, bg.height, bg.data, bg.width, bg.height, 0, 0, flags);
+        }
+    }
+    crowd.record(list, 2);
+}
+
+// The slow present, on the render thread; latency is measured from the tick that recorded the frame
+struct SlowPresent : FrameSink {
+    double present_ms = 0.0;
+    const std::vector<uint64_t>* tick_start_ns = nullptr;
+    std::vector<double> latency_ms;
+
+    void presentFrame(const RenderedFrame& frame) override {
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(present_ms * 1000.0)));
+        latency_ms.push_back((renderClockNs() - (*tick_start_ns)[frame.sequence - 1]) / 1e6);
+    }
+};
+
+struct RunResult {
+    double tick_hz, game_ms, shown_fps, p50, p95, p99;
+    uint64_t dropped;
+    std::vector<uint16_t> last_frame;
+};
+
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(p * (values.size() - 1) + 0.5))];
+}
+
+static RunResult run(bool threaded, int frames, double present_ms, size_t crowd_size) {
+    const SpriteFrame* sprites[DIGI_COUNT];
+    for (int d = 0; d < DIGI_COUNT; ++d) sprites[d] = kDigimonRoster[d].sprites;
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> pick_digimon(0, DIGI_COUNT - 1);
+    std::uniform_real_distribution<float> pick_x(0.0f, kScreen + 192.0f);
+    std::uniform_real_distribution<float> pick_y(kScreen / 2.0f, kScreen + 60.0f);
+    EntityStore store;
+    CrowdRenderer crowd;
+    crowd.setViewport(kScreen, kScreen);
+    crowd.setCameraX(96);
+    for (size_t i = 0; i < crowd_size; ++i) {
+        store.create(static_cast<DigimonType>(pick_digimon(rng)), ACTION_WALK, pick_x(rng), pick_y(rng), 1.0f, 0, true);
+    }
+
+    std::vector<uint64_t> tick_start_ns(frames);
+    SlowPresent presenter;
+    presenter.present_ms = present_ms;
+    presenter.tick_start_ns = &tick_start_ns;
+    presenter.latency_ms.reserve(frames);
+
+    RenderThread render_thread;
+    ScanlineCompositor compositor; // Inline
+    std::vector<uint16_t> framebuffer(static_cast<size_t>(kScreen) * kScreen);
+    BlitSurface target = {framebuffer.data(), kScreen, kScreen, kScreen, PixelFormat::RGB565};
+    for (const Background& bg : kBackgrounds) {
+        render_thread.cacheLayer(bg.data, bg.width, bg.height, kEffectiveBgWidth);
+        compositor.cacheLayer(bg.data, bg.width, bg.height, kEffectiveBgWidth);
+    }
+    if (threaded) render_thread.start(kScreen, kScreen, PixelFormat::RGB565, &presenter);
+
+    DrawList list(crowd_size + 16);
+    using clock = std::chrono::steady_clock;
+    double game_ms = 0.0;
+    const clock::time_point start = clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        std::this_thread::sleep_until(start + std::chrono::milliseconds(frame * kTickMs)); // Late ticks just start late
+        clock::time_point tick = clock::now();
+        tick_start_ns[frame] = renderClockNs();
+
+        store.updateAnimations(static_cast<uint32_t>(frame) * kTickMs);
+        store.updateMovement(1.0f, kScreen + 192.0f);
+        crowd.prepare(store, sprites);
+        recordScene(list, frame, crowd);
+        if (threaded) {
+            render_thread.submit(list, false, 1);
+        } else {
+            compositor.compose(list, target);
+            std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(present_ms * 1000.0)));
+            presenter.latency_ms.push_back((renderClockNs() - tick_start_ns[frame]) / 1e6);
+        }
+        game_ms += std::chrono::duration<double, std::milli>(clock::now() - tick).count();
+    }
+    const double game_seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+    RunResult result = {};
+    result.last_frame = framebuffer;
+    if (threaded) {
+        // The last snapshot is never dropped: wait for it to be shown
+        for (const RenderedFrame* shown = nullptr; !shown || shown->sequence != static_cast<uint64_t>(frames);) {
+            if (const RenderedFrame* frame = render_thread.latestFrame()) shown = frame;
+            else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (shown && shown->sequence == static_cast<uint64_t>(frames)) {
+                std::memcpy(result.last_frame.data(), shown->pixels.data(), shown->pixels.size());
+            }
+        }
+        render_thread.stop();
+        result.dropped = render_thread.dropped();
+    }
+    const double shown_seconds = std::chrono::duration<double>(clock::now() - start).count();
+    result.tick_hz = frames / game_seconds;
+    result.game_ms = game_ms / frames;
+    result.shown_fps = presenter.latency_ms.size() / shown_seconds;
+    result.p50 = percentile(presenter.latency_ms, 0.50);
+    result.p95 = percentile(presenter.latency_ms, 0.95);
+    result.p99 = percentile(presenter.latency_ms, 0.99);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    const int frames = (argc > 1) ? std::atoi(argv[1]) : 240;
+    const double present_ms = (argc > 2) ? std::atof(argv[2]) : 20.0;
+    const size_t crowd_size = (argc > 3) ? static_cast<size_t>(std::atoi(argv[3])) : 100;
+    if (frames < 1) return 1;
+
+    std::printf("%d ticks at %d ms, %dx%d, %zu sprites, present %.1f ms\n", frames, kTickMs, kScreen, kScreen, crowd_size, present_ms);
+    std::printf("%-14s %9s %13s %10s %9s %9s %9s %9s\n", "mode", "tick Hz", "game ms/tick", "shown fps",
+                "dropped", "p50 ms", "p95 ms", "p99 ms");
+    RunResult inline_run = run(false, frames, present_ms, crowd_size);
+    RunResult threaded_run = run(true, frames, present_ms, crowd_size);
+    for (const RunResult* r : {&inline_run, &threaded_run}) {
+        std::printf("%-14s %9.1f %13.3f %10.1f %9llu %9.2f %9.2f %9.2f\n", r == &inline_run ? "inline" : "render thread",
+                    r->tick_hz, r->game_ms, r->shown_fps, static_cast<unsigned long long>(r->dropped), r->p50, r->p95, r->p99);
+    }
+    std::printf("last frame identical: %s\n", inline_run.last_frame == threaded_run.last_frame ? "yes" : "NO");
+    return 0;
+}
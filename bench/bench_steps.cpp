@@ -0,0 +1,69 @@
+// Benchmark: the accelerometer step-detection pipeline (StepDetector) at sensor rates from 50 to
+// 1000 Hz. Samples are generated (or read from a CSV recording) up front, then fed through the
+// detector in FIFO-sized batches on one core. "core at rate" is the share of that core the
+// pipeline needs to keep up with a live sensor: what it costs a wearable's power budget.
+// Usage: bench_steps [seconds of walking] [batch size] [recording.csv rate_hz]
+#include "AccelSource.h"
+#include "StepDetector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct Result {
+    double samples_per_s;
+    uint32_t steps;
+    uint32_t cadence_events;
+};
+
+static Result run(const std::vector<AccelSample>& samples, int rate_hz, size_t batch) {
+    StepDetector detector(rate_hz);
+    StepEvent events[64];
+    uint32_t cadence_events = 0;
+    using clock = std::chrono::steady_clock;
+    clock::time_point t0 = clock::now();
+    for (size_t i = 0; i < samples.size(); i += batch) {
+        size_t count = samples.size() - i < batch ? samples.size() - i : batch;
+        size_t written = detector.process(samples.data() + i, count, events, 64);
+        for (size_t e = 0; e < written; ++e) cadence_events += events[e].type == STEP_EVENT_CADENCE;
+    }
+    double seconds = std::chrono::duration<double>(clock::now() - t0).count();
+    return {seconds > 0.0 ? samples.size() / seconds : 0.0, detector.steps(), cadence_events};
+}
+
+static std::vector<AccelSample> readAll(AccelSource& source) {
+    std::vector<AccelSample> samples;
+    AccelSample chunk[256];
+    size_t got;
+    while ((got = source.read(chunk, 256)) > 0) samples.insert(samples.end(), chunk, chunk + got);
+    return samples;
+}
+
+int main(int argc, char* argv[]) {
+    const uint32_t seconds = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 600;
+    const size_t batch = (argc > 2) ? static_cast<size_t>(std::atoi(argv[2])) : 32;
+    if (seconds < 1 || batch < 1) return 1;
+
+    std::printf("%u s of generated walking (20 s walk / 5 s stand, 110 steps/min), %zu-sample batches\n", seconds, batch);
+    std::printf("%8s %12s %14s %10s %14s %10s %10s\n", "rate Hz", "samples", "samples/s", "ns/sample", "core at rate",
+                "steps", "generated");
+    for (int rate : {50, 100, 200, 400, 1000}) {
+        SyntheticAccelSource source(rate, 110, 1234, seconds);
+        std::vector<AccelSample> samples = readAll(source);
+        Result r = run(samples, rate, batch);
+        std::printf("%8d %12zu %14.0f %10.2f %13.4f%% %10u %10u\n", rate, samples.size(), r.samples_per_s,
+                    1e9 / r.samples_per_s, 100.0 * rate / r.samples_per_s, r.steps, source.stepsGenerated());
+    }
+
+    if (argc > 4) { // A real recording too
+        const int rate = std::atoi(argv[4]);
+        CsvAccelSource csv(rate);
+        if (!csv.open(argv[3])) return 1;
+        std::vector<AccelSample> samples = readAll(csv);
+        Result r = run(samples, csv.rateHz(), batch);
+        std::printf("%s: %zu samples at %d Hz, %.0f samples/s, %u steps, %u cadence changes\n", argv[3], samples.size(),
+                    csv.rateHz(), r.samples_per_s, r.steps, r.cadence_events);
+    }
+    return 0;
+}
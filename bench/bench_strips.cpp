@@ -0,0 +1,125 @@
+// Benchmark: strip-buffer rendering (StripDisplay) at different strip heights.
+// Each height renders the same frames (the game's three parallax layers plus a 100-sprite
+// crowd) twice: with instant flushes, and with flushes that take as long as a panel bus of
+// the given bandwidth would. Reports the renderer's peak RAM against a full framebuffer,
+// throughput, and how long compositing stalled on the flush thread. The panel contents are
+// checked against the same frames composited whole.
+// Usage: bench_strips [frames] [bus MB/s]
+#include "CrowdRenderer.h"
+#include "EntityStore.h"
+#include "Blitter.h"
+#include "ScanlineCompositor.h"
+#include "platform/DrawList.h"
+#include "platform/headless/StripDisplay.h"
+#include "castlebackground0.h"
+#include "castlebackground1.h"
+#include "castlebackground2.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const int kScreen = 466;
+static const int kEffectiveBgWidth = 947;
+static const size_t kCrowdSize = 100;
+
+struct Background { const uint16_t* data; int width, height; float speed; uint8_t layer; };
+static const Background kBackgrounds[] = {
+    {castlebackground2_data, CASTLEBACKGROUND2_WIDTH, CASTLEBACKGROUND2_HEIGHT, 0.5f, 0},
+    {castlebackground1_data, CASTLEBACKGROUND1_WIDTH, CASTLEBACKGROUND1_HEIGHT, 1.0f, 1},
+    {castlebackground0_data, CASTLEBACKGROUND0_WIDTH, CASTLEBACKGROUND0_HEIGHT, 3.0f, 3},
+};
+
+// As Game::render with the crowd: backgrounds one period wide, characters on layer 2
+static void recordScene(DrawList& list, int frame, const CrowdRenderer& crowd) {
+    list.reset();
+    list.setClip(0, 0, kScreen, kScreen);
+    list.clear(0x0000);
+    for (const Background& bg : kBackgrounds) {
+        uint8_t flags = isOpaque(bg.data, static_cast<long>(bg.width) * bg.height) ? DRAW_OPAQUE : DRAW_COLOR_KEY;
+        for (int x = -(static_cast<int>(frame * bg.speed) % kEffectiveBgWidth); x < kScreen; x += kEffectiveBgWidth) {
+            list.blit(bg.layer, x, 0, kEffectiveBgWidth, bg.height, bg.data, bg.width, bg.height, 0, 0, flags);
+        }
+    }
+    crowd.record(list, 2);
+}
+
+struct RunResult { double ms_per_frame, stall_percent; size_t peak_bytes; bool identical; };
+
+static RunResult run(int strip_rows, double bus_bytes_per_second, int frames) {
+    StripDisplay display(strip_rows);
+    display.init("strips", kScreen, kScreen);
+    display.setBusBytesPerSecond(bus_bytes_per_second);
+
+    const SpriteFrame* sprites[DIGI_COUNT];
+    for (int d = 0; d < DIGI_COUNT; ++d) sprites[d] = kDigimonRoster[d].sprites;
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> pick_digimon(0, DIGI_COUNT - 1);
+    std::uniform_real_distribution<float> pick_x(0.0f, kScreen + 192.0f);
+    std::uniform_real_distribution<float> pick_y(kScreen / 2.0f, kScreen + 60.0f);
+    EntityStore store;
+    CrowdRenderer crowd;
+    crowd.setViewport(kScreen, kScreen);
+    crowd.setCameraX(96);
+    for (size_t i = 0; i < kCrowdSize; ++i) {
+        store.create(static_cast<DigimonType>(pick_digimon(rng)), ACTION_WALK, pick_x(rng), pick_y(rng), 1.0f, 0, true);
+    }
+
+    // Reference: the same frames composited into a whole RGB565 framebuffer
+    ScanlineCompositor reference;
+    std::vector<uint16_t> expected(static_cast<size_t>(kScreen) * kScreen);
+    BlitSurface expected_surface = {expected.data(), kScreen, kScreen, kScreen, PixelFormat::RGB565};
+
+    DrawList list(kCrowdSize + 16);
+    using clock = std::chrono::steady_clock;
+    RunResult result = {0.0, 0.0, 0, true};
+    uint64_t busy_ns = 0, wait_ns = 0;
+    double total_ms = 0.0;
+    for (int frame = 0; frame < frames; ++frame) {
+        store.updateAnimations(static_cast<uint32_t>(frame) * 16);
+        store.updateMovement(1.0f, kScreen + 192.0f);
+        crowd.prepare(store, sprites);
+
+        recordScene(list, frame, crowd);
+        clock::time_point t0 = clock::now();
+        display.submit(list);
+        display.present();
+        total_ms += std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+        busy_ns += display.renderer().stats().busy_ns;
+        wait_ns += display.renderer().stats().wait_ns;
+        if (display.renderer().memoryBytes() > result.peak_bytes) result.peak_bytes = display.renderer().memoryBytes();
+
+        recordScene(list, frame, crowd);
+        reference.compose(list, expected_surface);
+        result.identical = result.identical &&
+                           std::memcmp(display.panel(), expected.data(), expected.size() * sizeof(uint16_t)) == 0;
+    }
+    result.ms_per_frame = total_ms / frames;
+    result.stall_percent = busy_ns + wait_ns ? 100.0 * wait_ns / (busy_ns + wait_ns) : 0.0;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    const int frames = (argc > 1) ? std::atoi(argv[1]) : 120;
+    const double bus_mb_per_second = (argc > 2) ? std::atof(argv[2]) : 40.0; // ~80 MHz QSPI
+    const int strip_heights[] = {1, 2, 4, 8, 16, 32, 64, kScreen};
+    const double framebuffer_kb = kScreen * kScreen * sizeof(uint16_t) / 1024.0;
+
+    std::printf("%d frames, %dx%d, %zu sprites; full RGB565 framebuffer %.1f KB; bus %.1f MB/s\n",
+                frames, kScreen, kScreen, kCrowdSize, framebuffer_kb, bus_mb_per_second);
+    std::printf("%6s %11s %11s %12s %10s %12s %10s %10s\n", "rows", "strips KB", "peak KB", "instant ms",
+                "fps", "bus ms", "fps", "stall %");
+    for (int rows : strip_heights) {
+        const double strips_kb = 2.0 * kScreen * rows * sizeof(uint16_t) / 1024.0;
+        RunResult instant = run(rows, 0.0, frames);
+        RunResult bus = run(rows, bus_mb_per_second * 1e6, frames);
+        std::printf("%6d %11.1f %11.1f %12.3f %10.1f %12.3f %10.1f %10.1f%s\n", rows, strips_kb,
+                    (instant.peak_bytes > bus.peak_bytes ? instant.peak_bytes : bus.peak_bytes) / 1024.0,
+                    instant.ms_per_frame, 1000.0 / instant.ms_per_frame, bus.ms_per_frame, 1000.0 / bus.ms_per_frame,
+                    bus.stall_percent, instant.identical && bus.identical ? "" : "  OUTPUT DIFFERS");
+    }
+    return 0;
+}
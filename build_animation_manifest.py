@@ -0,0 +1,215 @@
+# Python Script: build_animation_manifest.py (Compiles assets/animations.manifest into constexpr C++ tables)
+# Run by the CMake build whenever the manifest, a sprite header or this script changes.
+import io
+import os
+import re
+import sys
+
+# --- Configuration ---
+assets_folder = "assets"
+manifest_name = "animations.manifest"
+header_name = "animation_manifest.h"          # Enums and constexpr clip tables; safe to include anywhere
+data_header_name = "animation_manifest_data.h" # Sprite source tables; include from ONE .cpp only
+required_actions = ["Idle", "Walk"]
+
+# --- Helpers ---
+def fail(line_no, message):
+    print(f"Error: {manifest_name}:{line_no}: {message}", file=sys.stderr)
+    sys.exit(1)
+
+def write_if_changed(path, text):
+    # An unchanged header keeps its contents (and line endings) but is touched, so the build
+    # sees it as up to date
+    try:
+        with open(path, "r") as f: same = f.read() == text
+    except OSError: same = False
+    if same:
+        os.utime(path)
+    else:
+        with open(path, "w") as f: f.write(text)
+
+def c_enum_name(prefix, name):
+    return prefix + re.sub(r'[^A-Za-z0-9]', '_', name).upper()
+
+def parse_manifest(path):
+    actions = []
+    characters = [] # [{"name", "sprites": [sprite names], "clips": {action: (loops, [(sprite_idx, ms)])}}]
+    with open(path, "r") as f:
+        for line_no, raw in enumerate(f, 1):
+            line = raw.split("#", 1)[0].strip()
+            if not line: continue
+            words = line.split()
+            if words[0] == "actions":
+                if actions: fail(line_no, "'actions' given twice")
+                actions = words[1:]
+                for required in required_actions:
+                    if required not in actions: fail(line_no, f"action '{required}' is required")
+            elif words[0] == "character":
+                if len(words) != 2: fail(line_no, "expected 'character <Name>'")
+                if not actions: fail(line_no, "'actions' must come before the first character")
+                if any(c["name"] == words[1] for c in characters): fail(line_no, f"character '{words[1]}' defined twice")
+                characters.append({"name": words[1], "sprites": [], "clips": {}})
+            else:
+                if not characters: fail(line_no, "clip outside of a character")
+                character = characters[-1]
+                if len(words) < 4: fail(line_no, "expected '<Action> loop|once <ms> <Sprite>[:ms] ...'")
+                action, mode, default_ms, frame_words = words[0], words[1], words[2], words[3:]
+                if action not in actions: fail(line_no, f"unknown action '{action}'")
+                if action in character["clips"]: fail(line_no, f"{character['name']} {action} defined twice")
+                if mode not in ("loop", "once"): fail(line_no, f"expected 'loop' or 'once', got '{mode}'")
+                if not default_ms.isdigit(): fail(line_no, f"bad duration '{default_ms}'")
+                frames = []
+                for word in frame_words:
+                    sprite, _, ms = word.partition(":")
+                    ms = ms or default_ms
+                    if not ms.isdigit() or not (0 < int(ms) <= 0xFFFF): fail(line_no, f"bad duration in '{word}'")
+                    if sprite not in character["sprites"]: character["sprites"].append(sprite)
+                    frames.append((character["sprites"].index(sprite), int(ms)))
+                if len(frames) > 255: fail(line_no, "too many frames in one clip")
+                character["clips"][action] = (mode == "loop", frames)
+    if not characters: fail(0, "no characters defined")
+    for character in characters:
+        for required in required_actions:
+            if required not in character["clips"]: fail(0, f"{character['name']} is missing required action '{required}'")
+        if len(character["sprites"]) > 255: fail(0, f"{character['name']} uses too many sprites")
+    return actions, characters
+
+# Reads a sprite header's (width, height, pixels)
+def load_sprite(assets_dir, character, sprite):
+    header = f"{character}_{sprite}.h"
+    path = os.path.join(assets_dir, header)
+    if not os.path.isfile(path):
+        print(f"Error: sprite header '{header}' not found in {assets_dir}", file=sys.stderr); sys.exit(1)
+    with open(path, "r") as f: text = f.read()
+    prefix = f"{character}_{sprite}".upper()
+    width = int(re.search(rf"#define {prefix}_WIDTH (\d+)", text).group(1))
+    height = int(re.search(rf"#define {prefix}_HEIGHT (\d+)", text).group(1))
+    body = text[text.index(f"{character}_{sprite}_data[]"):]
+    pixels = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]+", body[body.index("{"):body.index("}")])]
+    if len(pixels) != width * height:
+        print(f"Error: {header} has {len(pixels)} pixels, expected {width}x{height}", file=sys.stderr); sys.exit(1)
+    return width, height, pixels
+
+# Bounding rect (x, y, w, h) of the pixels that change going from sprite 'a' to sprite 'b';
+# w = 0 if nothing changes, the whole of 'b' if the sizes differ
+def diff_rect(a, b):
+    (aw, ah, ap), (bw, bh, bp) = a, b
+    if (aw, ah) != (bw, bh): return (0, 0, bw, bh)
+    if ap == bp: return (0, 0, 0, 0)
+    rows = [y for y in range(bh) if ap[y * bw:(y + 1) * bw] != bp[y * bw:(y + 1) * bw]]
+    columns = [x for x in range(bw) if any(ap[y * bw + x] != bp[y * bw + x] for y in rows)]
+    return (columns[0], rows[0], columns[-1] - columns[0] + 1, rows[-1] - rows[0] + 1)
+
+# For every frame of every clip: what changes since the frame before it in play order (the
+# clip's last frame for its first, as clips are restarted/looped back to back).
+# Also returns the total area of the frames, for the summary.
+def build_frame_diffs(assets_dir, actions, characters):
+    diffs, frame_area = [], 0
+    for character in characters:
+        sprites = [load_sprite(assets_dir, character["name"], sprite) for sprite in character["sprites"]]
+        for action in actions:
+            if action not in character["clips"]: continue
+            _, clip_frames = character["clips"][action]
+            for i, (sprite, _) in enumerate(clip_frames):
+                diffs.append(diff_rect(sprites[clip_frames[i - 1][0]], sprites[sprite]))
+                frame_area += sprites[sprite][0] * sprites[sprite][1]
+    return diffs, frame_area
+
+# Flattens every clip into one frame table; clips index it as [character][action]
+def build_tables(actions, characters):
+    frames, clips = [], []
+    for character in characters:
+        row = []
+        for action in actions:
+            if action not in character["clips"]:
+                row.append((0, 0, False, 0)); continue
+            loops, clip_frames = character["clips"][action]
+            first, start_ms = len(frames), 0
+            for sprite, ms in clip_frames:
+                frames.append((sprite, ms, start_ms)) # start_ms = prefix sum of earlier durations
+                start_ms += ms
+            row.append((first, len(clip_frames), loops, start_ms))
+        clips.append(row)
+    if len(frames) > 0xFFFF: print("Error: too many frames for 16-bit frame indices", file=sys.stderr); sys.exit(1)
+    return frames, clips
+
+def write_header(path, actions, characters, frames, clips, diffs):
+    with io.StringIO() as f:
+        f.write(f"// Generated by build_animation_manifest.py from {manifest_name} - do not edit\n\n")
+        f.write("#ifndef ANIMATION_MANIFEST_H\n#define ANIMATION_MANIFEST_H\n\n")
+        f.write('#include <cstdint>\n#include "animation.h" // AnimFrameRef, AnimFrameDiff, AnimClipDef\n\n')
+        f.write("enum DigimonType {\n")
+        for character in characters: f.write(f"    {c_enum_name('DIGI_', character['name'])},\n")
+        f.write("    DIGI_COUNT\n};\n\n")
+        f.write("enum AnimAction {\n")
+        for action in actions: f.write(f"    {c_enum_name('ACTION_', action)},\n")
+        f.write("    ACTION_COUNT\n};\n\n")
+        f.write(f"#define ANIMATION_MANIFEST_FRAME_COUNT {len(frames)}\n\n")
+        f.write("// { sprite, duration_ms } for every clip, back to back\n")
+        f.write("inline constexpr AnimFrameRef kAnimFrameRefs[ANIMATION_MANIFEST_FRAME_COUNT] = {\n")
+        for i in range(0, len(frames), 8):
+            f.write("    " + " ".join(f"{{ {sprite}, {ms} }}," for sprite, ms, _ in frames[i:i + 8]) + "\n")
+        f.write("};\n\n")
+        f.write("// Start of each frame relative to its clip (prefix sum of durations)\n")
+        f.write("inline constexpr uint32_t kAnimFrameStartMs[ANIMATION_MANIFEST_FRAME_COUNT] = {\n")
+        for i in range(0, len(frames), 12):
+            f.write("    " + " ".join(f"{start}," for _, _, start in frames[i:i + 12]) + "\n")
+        f.write("};\n\n")
+        f.write("// { x, y, w, h } sprite-space rect of the pixels that differ from the previous frame in the clip\n")
+        f.write("// (the last frame, for the first); w = 0 if the frames are identical\n")
+        f.write("inline constexpr AnimFrameDiff kAnimFrameDiffs[ANIMATION_MANIFEST_FRAME_COUNT] = {\n")
+        for i in range(0, len(diffs), 6):
+            f.write("    " + " ".join(f"{{ {x}, {y}, {w}, {h} }}," for x, y, w, h in diffs[i:i + 6]) + "\n")
+        f.write("};\n\n")
+        f.write("// { first_frame, frame_count, loops, total_ms } per [character][action]; frame_count 0 = no clip\n")
+        f.write("inline constexpr AnimClipDef kAnimClips[DIGI_COUNT][ACTION_COUNT] = {\n")
+        for character, row in zip(characters, clips):
+            entries = " ".join(f"{{ {first}, {count}, {'true' if loops else 'false'}, {total} }}," for first, count, loops, total in row)
+            f.write(f"    {{ {entries} }}, // {character['name']}\n")
+        f.write("};\n\n")
+        f.write("#endif // ANIMATION_MANIFEST_H\n")
+        write_if_changed(path, f.getvalue())
+
+def write_data_header(path, assets_dir, characters):
+    with io.StringIO() as f:
+        f.write(f"// Generated by build_animation_manifest.py from {manifest_name} - do not edit\n")
+        f.write("// Defines the sprite tables, so include it from exactly one .cpp file\n\n")
+        f.write("#ifndef ANIMATION_MANIFEST_DATA_H\n#define ANIMATION_MANIFEST_DATA_H\n\n")
+        f.write('#include <cstdint>\n#include "DigimonRoster.h" // DigimonDef, generated enums\n\n')
+        for character in characters:
+            for sprite in character["sprites"]:
+                header = f"{character['name']}_{sprite}.h"
+                if not os.path.isfile(os.path.join(assets_dir, header)):
+                    print(f"Error: sprite header '{header}' not found in {assets_dir}", file=sys.stderr); sys.exit(1)
+                f.write(f'#include "{header}"\n')
+        f.write("\n")
+        for character in characters:
+            f.write(f"static const SpriteFrame k{character['name']}Sprites[] = {{\n")
+            for sprite in character["sprites"]:
+                prefix = f"{character['name']}_{sprite}".upper()
+                f.write(f"    {{ {prefix}_WIDTH, {prefix}_HEIGHT, {character['name']}_{sprite}_data }},\n")
+            f.write("};\n")
+        f.write("\nconst DigimonDef kDigimonRoster[DIGI_COUNT] = {\n")
+        for character in characters:
+            f.write(f"    {{ \"{character['name']}\", k{character['name']}Sprites, {len(character['sprites'])} }},\n")
+        f.write("};\n\n#endif // ANIMATION_MANIFEST_DATA_H\n")
+        write_if_changed(path, f.getvalue())
+
+# --- Main ---
+try:
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    assets_dir = os.path.join(script_dir, assets_folder)
+    manifest_path = os.path.join(assets_dir, manifest_name)
+    if not os.path.isfile(manifest_path):
+        print(f"Error: Manifest not found: {manifest_path}", file=sys.stderr); sys.exit(1)
+    actions, characters = parse_manifest(manifest_path)
+    frames, clips = build_tables(actions, characters)
+    diffs, frame_area = build_frame_diffs(assets_dir, actions, characters)
+    write_header(os.path.join(assets_dir, header_name), actions, characters, frames, clips, diffs)
+    write_data_header(os.path.join(assets_dir, data_header_name), assets_dir, characters)
+    clip_count = sum(len(c["clips"]) for c in characters)
+    diff_area = sum(w * h for _, _, w, h in diffs)
+    print(f"Compiled {len(characters)} characters x {len(actions)} actions ({clip_count} clips, {len(frames)} frames).")
+    print(f"Frame diffs cover {100.0 * diff_area / frame_area:.1f}% of the frame area.")
+except SystemExit: raise
+except Exception as e: print(f"A critical error occurred: {e}", file=sys.stderr); sys.exit(1)
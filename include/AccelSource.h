@@ -0,0 +1,60 @@
+#ifndef ACCEL_SOURCE_H
+#define ACCEL_SOURCE_H
+
+#include "StepDetector.h" // AccelSample
+#include <stdint.h>
+#include <stdio.h>
+
+// Where accelerometer samples come from: a sensor driver on the device, a recording or a
+// generator on the PC. Samples are delivered in order at rateHz(), as fast as read() is called.
+class AccelSource {
+public:
+    virtual ~AccelSource() = default;
+
+    virtual int rateHz() const = 0;
+    // Up to 'max' samples into 'out'; 0 once there are no more
+    virtual size_t read(AccelSample* out, size_t max) = 0;
+};
+
+// A CSV recording, one sample per line: "x,y,z" in g, or "t,x,y,z" with a leading timestamp
+// column (ignored: samples are taken to be evenly spaced at the given rate). Lines that don't
+// start with a number (headers, '#' comments) are skipped.
+class CsvAccelSource final : public AccelSource {
+public:
+    explicit CsvAccelSource(int rate_hz = 100);
+    ~CsvAccelSource() override;
+
+    bool open(const char* path); // false if it can't be read
+    int rateHz() const override { return rate; }
+    size_t read(AccelSample* out, size_t max) override;
+
+private:
+    FILE* file;
+    int rate;
+};
+
+// Walking, generated: the vertical bounce of each step plus its harmonic, a sideways sway at
+// half the step rate, gravity on a tilted axis and sensor noise, at a cadence that drifts +-5%.
+// Walks for 20 s, stands still for 5, and so on; the same seed gives the same samples.
+class SyntheticAccelSource final : public AccelSource {
+public:
+    SyntheticAccelSource(int rate_hz = 100, int cadence = 110, uint32_t seed = 1, uint32_t duration_s = 0); // 0 = endless
+
+    int rateHz() const override { return rate; }
+    size_t read(AccelSample* out, size_t max) override;
+    uint32_t stepsGenerated() const { return steps; } // Step peaks in the samples read so far
+
+private:
+    static const uint32_t WALK_S = 20, STAND_S = 5;
+
+    int rate;
+    double cadence_spm;
+    uint32_t noise;     // LCG state
+    uint64_t sample;    // Next sample's index
+    uint64_t end;       // Sample count to stop at, 0 = never
+    double phase;       // Through the current step, 0..1
+    uint32_t cycles;    // Whole steps taken
+    uint32_t steps;     // Bounce peaks generated
+};
+
+#endif // ACCEL_SOURCE_H
@@ -0,0 +1,97 @@
+#ifndef ASSET_MANAGER_H
+#define ASSET_MANAGER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "animation.h" // For SpriteFrame
+
+// Where a character's frames are loaded from (compiled-in arrays on PC, flash on device)
+struct AssetSource {
+    const SpriteFrame* frames = nullptr;
+    int frame_count = 0;
+};
+
+// A character's frames once decoded into RAM. Frame i matches AssetSource::frames[i].
+struct CharacterAssets {
+    std::vector<uint16_t> pixels;    // All frames back to back
+    std::vector<SpriteFrame> frames; // Point into 'pixels'
+    size_t bytes = 0;
+};
+
+// Loads characters on first use and keeps them in an LRU cache bounded by a byte budget.
+// Loads requested with pinAsync()/prefetch() run on a background worker thread.
+//
+// Pinned characters are never evicted, so pointers returned by find()/pinAndLoad() stay
+// valid until the matching unpin(). Speculative prefetches are dropped rather than
+// pushing the cache over budget; only pinned characters may exceed it (with a warning).
+class AssetManager {
+public:
+    AssetManager(const std::vector<AssetSource>& sources, size_t budget_bytes);
+    ~AssetManager();
+
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    // Pin and load on the calling thread if needed (startup / unavoidable misses)
+    const CharacterAssets* pinAndLoad(int id);
+    // Pin now, load on the worker thread if needed; poll with find()
+    void pinAsync(int id);
+    // Speculatively load on the worker thread if there is room
+    void prefetch(int id);
+    // Resident assets of a character the caller has pinned, or nullptr if still loading
+    const CharacterAssets* find(int id);
+    void unpin(int id);
+
+    // Moves the frame pointers of characters evicted since the last call into 'evicted' (its
+    // old contents are dropped). Caches keyed by pixel address must forget them: the memory
+    // has been freed and a later load may get the same address.
+    void takeEvicted(std::vector<const uint16_t*>& evicted);
+
+    bool isResident(int id) const;
+    size_t residentBytes() const;
+    size_t budgetBytes() const { return budget_bytes; }
+    int count() const { return static_cast<int>(sources.size()); }
+
+private:
+    struct Entry {
+        std::unique_ptr<CharacterAssets> assets;
+        int pins = 0;
+        bool queued = false;
+        std::list<int>::iterator lru_pos; // Valid only while resident
+    };
+    struct Job {
+        int id;
+        bool speculative;
+    };
+
+    std::unique_ptr<CharacterAssets> decode(int id) const;
+    bool install(int id, std::unique_ptr<CharacterAssets> assets, bool speculative); // Caller holds 'mutex'
+    bool canFit(size_t bytes_needed, int keep_id) const;                             // Caller holds 'mutex'
+    bool makeRoom(size_t bytes_needed, int keep_id);                                 // Caller holds 'mutex'
+    void touch(int id);                                                               // Caller holds 'mutex'
+    void workerLoop();
+
+    std::vector<AssetSource> sources;
+    size_t budget_bytes;
+    size_t resident_bytes;
+
+    std::vector<Entry> entries;
+    std::list<int> lru; // Front = most recently used
+    std::vector<const uint16_t*> evicted_frames; // Since the last takeEvicted()
+
+    mutable std::mutex mutex;
+    std::condition_variable work_ready;
+    std::deque<Job> jobs;
+    bool stopping;
+    std::thread worker;
+};
+
+#endif // ASSET_MANAGER_H
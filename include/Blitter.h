@@ -0,0 +1,99 @@
+#ifndef BLITTER_H
+#define BLITTER_H
+
+#include <stdint.h>
+
+// Software blitter shared by the display backends.
+//
+// A blit is clipped exactly once (against the target, an optional clip rect and the source
+// buffer), then runs a row kernel instantiated from a template for its combination of source
+// format, target format, mode and flip. The combination is picked with a single table lookup,
+// and the inner loops contain no bounds checks.
+
+enum class PixelFormat : uint8_t {
+    RGB565,   // Asset format (and the panel's native format)
+    ARGB8888, // SDL streaming texture / headless framebuffer
+    COUNT
+};
+
+inline int bytesPerPixel(PixelFormat format) { return format == PixelFormat::RGB565 ? 2 : 4; }
+
+enum BlitMode : uint8_t {
+    BLIT_COPY,  // Opaque copy
+    BLIT_KEY,   // Skip colour-key pixels (magenta 0xF81F, or its ARGB8888 equivalent)
+    BLIT_ALPHA, // Colour key, then blend by source alpha (ARGB8888 only) times the blit's alpha
+    BLIT_MODE_COUNT
+};
+
+enum BlitFlip : uint8_t {
+    BLIT_FLIP_NONE = 0,
+    BLIT_FLIP_X    = 1 << 0,
+    BLIT_FLIP_Y    = 1 << 1
+};
+
+const uint16_t COLOR_KEY_RGB565 = 0xF81F;
+const uint32_t COLOR_KEY_ARGB8888 = 0xFFFF00FF;
+
+struct BlitRect {
+    int x, y, w, h;
+};
+
+struct BlitSurface {
+    void* pixels;
+    int width, height;
+    int stride; // In pixels
+    PixelFormat format;
+};
+
+struct BlitSource {
+    const void* pixels;
+    int width, height; // Whole source buffer
+    int stride;        // In pixels
+    PixelFormat format;
+};
+
+// Exact integer versions of (c * 255) / 31 and (c * 255) / 63, without the divisions.
+// Products stay below 2^16 so vectorised kernels can use 16-bit multiplies.
+inline uint32_t expand5(uint32_t c) { return static_cast<uint16_t>(c * 1053u) >> 7; }
+inline uint32_t expand6(uint32_t c) { return static_cast<uint16_t>(c * 259u + 3u) >> 6; }
+
+inline uint32_t rgb565ToArgb8888(uint16_t color) {
+    return 0xFF000000u | (expand5(color >> 11) << 16) | (expand6((color >> 5) & 0x3F) << 8) | expand5(color & 0x1F);
+}
+
+inline uint16_t argb8888ToRgb565(uint32_t color) {
+    return static_cast<uint16_t>(((color >> 8) & 0xF800) | ((color >> 5) & 0x07E0) | ((color >> 3) & 0x001F));
+}
+
+// Visible part of a blit and the source pixel that lands on its top-left corner
+struct BlitClip {
+    BlitRect dest;
+    int source_x, source_y;
+};
+
+// Clips a blit against the target, an optional clip rect and the source buffer (mirrored
+// windows included). Returns false if nothing is visible. blit() uses this; so can callers
+// that walk the visible pixels themselves.
+bool clipBlit(int target_width, int target_height, const BlitRect* clip,
+              int source_width, int source_height, int source_x, int source_y,
+              const BlitRect& dest, uint8_t flip, BlitClip& out);
+
+// Copies the (dest.w x dest.h) window at (source_x, source_y) of 'source' to 'dest' on 'target',
+// limited to 'clip' (pass nullptr for the whole target). With BLIT_FLIP_X/Y the window is mirrored.
+// Returns the number of destination pixels the kernel visited (0 if fully clipped).
+int blit(const BlitSurface& target, const BlitRect* clip,
+         const BlitSource& source, int source_x, int source_y, const BlitRect& dest,
+         BlitMode mode = BLIT_KEY, uint8_t flip = BLIT_FLIP_NONE, uint8_t alpha = 255);
+
+// Copies one opaque run of 'count' source pixels to (x, y), reading backwards from 'source'
+// when flip_x. No clipping: for callers (the scanline compositor) that have already clipped.
+void blitRun(const BlitSurface& target, int x, int y, int count,
+             const void* source, PixelFormat source_format, bool flip_x);
+
+// True if no pixel is the colour key, i.e. the image covers everything it's drawn over
+bool isOpaque(const uint16_t* pixels, long count);
+
+// Fills 'rect' (clipped to the target) with an RGB565 colour converted to the target's format
+void fillRect(const BlitSurface& target, const BlitRect& rect, uint16_t color);
+
+#endif // BLITTER_H
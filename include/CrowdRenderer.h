@@ -0,0 +1,69 @@
+#ifndef CROWD_RENDERER_H
+#define CROWD_RENDERER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "DigimonRoster.h" // DIGI_COUNT, SpriteFrame
+
+class DrawList;
+class EntityStore;
+
+// Draws every entity of an EntityStore as a sprite, back to front by y.
+// Entity positions are the sprite's bottom-centre ("feet"), so lower on screen = in front.
+//
+// Each frame: off-screen sprites are culled, the rest are radix sorted on a 32-bit key of
+// (y, source image), then grouped by source frame so draws of one frame run back to back and
+// reuse its pixels while they're still in cache. A sprite only moves up to an earlier draw of
+// its frame if nothing drawn in between overlaps it, so every overlap keeps its y order.
+class CrowdRenderer {
+public:
+    CrowdRenderer();
+
+    void setViewport(int width, int height);
+    // World x shown at the left edge of the viewport
+    void setCameraX(int x) { camera_x = x; }
+    // Builds this frame's draw order. sprites_by_digimon[d] is Digimon d's resident sprite
+    // array, or nullptr if it isn't loaded (its entities are skipped). Reuses internal buffers.
+    void prepare(const EntityStore& store, const SpriteFrame* const sprites_by_digimon[DIGI_COUNT]);
+    // Records the sorted sprites into 'list' on 'layer' (the list's stable layer sort keeps the y order)
+    void record(DrawList& list, uint8_t layer) const;
+
+    int visibleCount() const { return static_cast<int>(draw_list.size()); }
+    int culledCount() const { return culled_count; }
+    int frameSwitchCount() const { return frame_switches; } // Draws whose source frame differs from the previous draw
+    int sortedFrameSwitchCount() const { return sorted_frame_switches; } // The same in plain y order (before grouping)
+
+private:
+    struct SpriteDraw {
+        int16_t x, y; // Top-left on screen
+        const SpriteFrame* frame;
+    };
+    // Consecutive draws of one frame in the output, chained through 'next_in_batch'
+    struct Batch {
+        const SpriteFrame* frame;
+        int x0, y0, x1, y1; // Bounds of its sprites
+        uint32_t first, last;
+    };
+    static const int BATCH_LOOKBACK = 64; // Batches searched back for one of the same frame
+
+    void radixSort();
+    void batchByFrame(); // draw_list (y order) -> draw_list (grouped)
+    int countFrameSwitches() const;
+
+    int viewport_width;
+    int viewport_height;
+    int camera_x;
+    int culled_count;
+    int frame_switches;
+    int sorted_frame_switches;
+
+    std::vector<uint32_t> keys, keys_tmp;       // (y << 16) | (digimon << 8) | sprite
+    std::vector<SpriteDraw> unsorted, draw_list; // Culled candidates, then sorted draws
+    std::vector<uint32_t> order, order_tmp;      // Indices into 'unsorted' travelling with the keys
+    std::vector<Batch> batches;
+    std::vector<uint32_t> next_in_batch;         // Per y-ordered draw: the next one in its batch
+    std::vector<SpriteDraw> batched;
+};
+
+#endif // CROWD_RENDERER_H
@@ -0,0 +1,30 @@
+#ifndef DIGIMON_ROSTER_H
+#define DIGIMON_ROSTER_H
+
+#include <stdint.h>
+#include "animation.h"          // For SpriteFrame, Animation
+#include "animation_manifest.h" // DigimonType, AnimAction and the constexpr clip tables (generated)
+
+enum PlayerState { STATE_IDLE, STATE_WALKING };
+
+// Static description of one Digimon: where its (compiled-in) frames live.
+// The frame data here is the *source* for the AssetManager, never drawn from directly.
+struct DigimonDef {
+    const char* name;
+    const SpriteFrame* sprites; // Indexed by AnimFrameRef::sprite
+    int sprite_count;
+};
+
+extern const DigimonDef kDigimonRoster[DIGI_COUNT];
+
+constexpr bool hasAnimation(DigimonType digimon, AnimAction action) {
+    return kAnimClips[digimon][action].frame_count != 0;
+}
+
+// O(1) [digimon][action] lookup; the view draws from 'sprites' (the Digimon's resident frames).
+// Returns an empty Animation if the Digimon has no such clip.
+constexpr Animation animationFor(DigimonType digimon, AnimAction action, const SpriteFrame* sprites) {
+    return makeAnimation(kAnimClips[digimon][action], kAnimFrameRefs, kAnimFrameStartMs, sprites, kAnimFrameDiffs);
+}
+
+#endif // DIGIMON_ROSTER_H
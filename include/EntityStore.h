@@ -0,0 +1,49 @@
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "DigimonRoster.h" // DigimonType, AnimAction, clip tables
+
+// Struct-of-arrays store for many animated Digimon (party views, crowds, stress tests).
+// Each column is a flat array indexed by entity id, so the batched update kernels below
+// stream through exactly the fields they need.
+class EntityStore {
+public:
+    EntityStore() = default;
+
+    void reserve(size_t count);
+    void clear();
+    size_t size() const { return pos_x.size(); }
+
+    // Adds an entity playing 'action' from 'start_ms'; returns its index.
+    // 'repeat' keeps one-shot clips (Walk, Run...) cycling instead of holding their last frame.
+    // An out-of-range Digimon or action is created idle (as Agumon if the Digimon is bad).
+    size_t create(DigimonType digimon, AnimAction action, float x, float y, float speed_x, uint32_t start_ms,
+                  bool repeat = false);
+    // false (entity unchanged) if the entity or action is out of range
+    bool setAction(size_t entity, AnimAction action, uint32_t start_ms);
+
+    // --- Batched update kernels ---
+    // Samples every entity's clip at 'now_ms' (same maths as sampleAnimation); start times up to
+    // ~24 days either side of it are fine, later ones hold the first frame
+    void updateAnimations(uint32_t now_ms);
+    // Moves every entity by its speed, wrapping x into [0, world_width) (|speed * dt| < world_width)
+    void updateMovement(float dt_frames, float world_width);
+
+    // --- Columns (read freely; write through the methods above) ---
+    std::vector<float> pos_x;
+    std::vector<float> pos_y;
+    std::vector<float> speed_x;           // Pixels per 16 ms frame
+    std::vector<uint8_t> digimon;         // DigimonType
+    std::vector<uint8_t> action;          // AnimAction
+    std::vector<uint16_t> clip;           // digimon * ACTION_COUNT + action, cached for the kernel
+    std::vector<uint8_t> repeat;          // Non-zero: sample one-shot clips as loops
+    std::vector<uint32_t> anim_start_ms;  // Animation clock: when the current clip started
+    std::vector<uint16_t> frame_ref;      // Sampled frame as an index into kAnimFrameRefs
+    std::vector<uint32_t> anim_cycles;    // Completed cycles of the current clip
+};
+
+#endif // ENTITY_STORE_H
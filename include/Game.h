@@ -1,138 +1,174 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <string>
 #include <vector>
-#include <stdint.h> // For Uint32 etc.
+#include <stdint.h> // For uint32_t etc.
+#include <stddef.h> // For size_t
 
 // Forward declarations
-class IDisplay;
-class IInput;
-struct Animation; // Assuming animation.h defines this
-struct SpriteFrame; // Assuming animation.h defines this
-enum class InputAction; // From IInput.h
-enum PlayerState; // From old main.cpp
-enum DigimonType; // From old main.cpp
+class AssetManager;
+struct CharacterAssets;
+
+#include "platform/Platform.h" // PlatformDisplay / PlatformInput
 
 // Include necessary headers for data ONLY (minimal includes here)
 // Adjust path based on where you put the asset files
 #include "animation.h"
-#include "castlebackground0.h"
-#include "castlebackground1.h"
-#include "castlebackground2.h"
-// Include one Digimon header just to get the enums if they aren't separate
-#include "Agumon_Idle_0.h"
-#include "Agumon_Idle_1.h"
-#include "Agumon_Walk_0.h"
-#include "Agumon_Walk_1.h"
-#include "Gabumon_Idle_0.h"
-#include "Gabumon_Idle_1.h"
-#include "Gabumon_Walk_0.h"
-#include "Gabumon_Walk_1.h"
-#include "Biyomon_Idle_0.h"
-#include "Biyomon_Idle_1.h"
-#include "Biyomon_Walk_0.h"
-#include "Biyomon_Walk_1.h"
-#include "Gatomon_Idle_0.h"
-#include "Gatomon_Idle_1.h"
-#include "Gatomon_Walk_0.h"
-#include "Gatomon_Walk_1.h"
-#include "Gomamon_Idle_0.h"
-#include "Gomamon_Idle_1.h"
-#include "Gomamon_Walk_0.h"
-#include "Gomamon_Walk_1.h"
-#include "Palmon_Idle_0.h"
-#include "Palmon_Idle_1.h"
-#include "Palmon_Walk_0.h"
-#include "Palmon_Walk_1.h"
-#include "Tentomon_Idle_0.h"
-#include "Tentomon_Idle_1.h"
-#include "Tentomon_Walk_0.h"
-#include "Tentomon_Walk_1.h"
-#include "Patamon_Idle_0.h"
-#include "Patamon_Idle_1.h"
-#include "Patamon_Walk_0.h"
-#include "Patamon_Walk_1.h"
-
-
-// Define enums directly here if they are not in a separate header
-enum PlayerState { STATE_IDLE, STATE_WALKING };
-enum DigimonType { DIGI_AGUMON, DIGI_GABUMON, DIGI_BIYOMON, DIGI_GATOMON, DIGI_GOMAMON, DIGI_PALMON, DIGI_TENTOMON, DIGI_PATAMON, DIGI_COUNT };
-
+#include "DigimonRoster.h" // PlayerState, DigimonType, AnimAction and the animation table
+#include "EntityStore.h"
+#include "CrowdRenderer.h"
+#include "ParallaxScene.h"
+#include "QualityGovernor.h"
+#include "LatencyStats.h"
+#include "GameClock.h"
+#include "InputRecording.h"
+#include "platform/DrawList.h"
+
+class HeadlessDisplay;
+
+// How the game runs; the defaults are the interactive colour window
+struct GameOptions {
+    bool monochrome = false;    // Draw on a simulated 1bpp dot-matrix LCD (MonoDisplay) instead of in colour
+    bool render_thread = false; // Composite on a render thread (PCDisplay's render thread mode)
+    std::string record_path;    // Record the session's input to this file (InputRecording.h)
+    std::string replay_path;    // Play a recorded session back on a virtual clock instead of reading keys
+                                // (assets/replays/tour.rpl: the standard workload for timing builds)
+    bool headless = false;      // Replays only: draw in memory (HeadlessDisplay), no window, and hash the frames
+    std::string accel_path;     // Steps from an accelerometer: a CSV recording (AccelSource.h) or "synthetic"
+    int accel_rate_hz = 100;    // Its sample rate
+};
 
 class Game {
 public:
-    Game();
+    explicit Game(const GameOptions& options = GameOptions());
     ~Game();
 
+    // Scene files to load at startup (default: DIGIVICE_SCENE_DIR's castle and ramparts)
+    void setScenePaths(const std::vector<std::string>& paths) { scene_paths = paths; }
+    // Key binding file loaded at startup (default: DIGIVICE_INPUT_BINDINGS; empty = built-in keys)
+    void setBindingsPath(const std::string& path) { bindings_path = path; }
     bool initialize();
     void run();
     void cleanup();
 
 private:
     // --- Core Systems ---
-    IDisplay* display; // Pointer to the display interface
-    IInput* input;     // Pointer to the input interface
+    PlatformDisplay* display; // Display interface (or the concrete PC class when bound statically)
+    PlatformInput* input;     // Input interface (likewise)
+    AssetManager* assets; // Loads/caches Digimon sprites on demand
 
     // --- Game Loop Control ---
     bool isRunning;
+    uint32_t loop_wakeups;     // Loop passes since loop_stats_start
+    uint32_t loop_stats_start; // When the current wakeup/frame rate sample began
+    uint32_t loop_stats_frames; // frames_rendered at loop_stats_start
+    QualityGovernor governor;   // Trades detail for frame time when frames overrun
+    uint64_t present_ticks;     // Performance counter ticks spent in present() this loop pass (not work: it waits for vsync)
+    GameClock clock;            // Virtual while replaying: all game time comes from here
+
+    // --- Input Recording / Replay ---
+    std::string record_path;
+    InputRecorder recorder;
+    HeadlessDisplay* headless_display; // 'display' when replaying headless, else nullptr
+    uint32_t replay_hash;              // FNV-1a over every presented frame's frameHash()
+
+    // --- Input Latency (press arrival to the present() showing its effect) ---
+    uint64_t input_pressed_at; // IInput::pressTimestamp() of the press being measured, 0 = none
+    uint32_t input_frame;      // Submit number of the first frame showing it, 0 = not drawn yet
+    uint64_t select_pressed_at; // Press that selected the Digimon still loading: measured from the switch on
+    LatencyStats input_latency;
+
+    std::string bindings_path;
+
+    // --- Scenes (parallax backdrops, loaded from files) ---
+    std::vector<std::string> scene_paths;
+    std::vector<ParallaxScene> scenes; // All loaded up front: switching never touches the disk
+    size_t current_scene;
 
     // --- Game State Variables (from old main) ---
-    const uint16_t* bg_data_0;
-    const uint16_t* bg_data_1;
-    const uint16_t* bg_data_2;
-    float bg_scroll_offset_0;
-    float bg_scroll_offset_1;
-    float bg_scroll_offset_2;
 
     PlayerState current_state;
     DigimonType current_digimon;
-    Animation* active_anim;
+    DigimonType pending_digimon; // Selected but still loading (DIGI_COUNT = none)
+    const CharacterAssets* current_assets; // Pinned in the asset cache while current
+    // Released characters whose frames the display may still be drawing (render thread): each
+    // stays pinned until the display has shown the last frame submitted before its release
+    struct PendingUnpin {
+        DigimonType digimon;
+        uint32_t last_frame; // frames_rendered at release
+    };
+    std::vector<PendingUnpin> pending_unpins;
+    Animation active_anim; // View into the static clip tables
     int current_anim_frame_idx;
-    Uint32 last_anim_update_time;
+    uint32_t anim_start_time; // When active_anim started; frames are sampled from here
     int queued_steps;
 
-    // Digimon Animations (Declare them here for now)
-     Animation agumon_idle_anim, agumon_walk_anim;
-     Animation gabumon_idle_anim, gabumon_walk_anim;
-     Animation biyomon_idle_anim, biyomon_walk_anim;
-     Animation gatomon_idle_anim, gatomon_walk_anim;
-     Animation gomamon_idle_anim, gomamon_walk_anim;
-     Animation palmon_idle_anim, palmon_walk_anim;
-     Animation tentomon_idle_anim, tentomon_walk_anim;
-     Animation patamon_idle_anim, patamon_walk_anim;
+    AnimAction current_action;
+
+    // --- Crowd Mode (many Digimon instead of the single centred one) ---
+    static constexpr int CROWD_SIZE = 24;
+    bool crowd_mode;
+    bool crowd_pinned; // crowd_neighbours are pinned in the asset cache
+    DigimonType crowd_neighbours[2];
+    EntityStore crowd;
+    CrowdRenderer crowd_renderer;
+
+    // --- Rendering ---
+    // Two tiles for each of the most layers a scene can have, plus the crowd (or the hero);
+    // loadScenes() makes room for scenes whose tiles are narrower than the screen
+    static constexpr size_t MAX_FRAME_DRAWS = ParallaxScene::MAX_LAYERS * 2 + CROWD_SIZE;
+    DrawList frame_list; // Recorded each frame and handed to display->submit()
+    uint32_t frames_rendered;
+    bool heat_map; // Debug overdraw overlay (display->setHeatMap)
+    std::vector<const uint16_t*> evicted_sprites; // AssetManager::takeEvicted() into display->forgetSource()
+
+    // --- Damage Tracking (what the last submitted frame showed) ---
+    struct HeroDraw {
+        const SpriteFrame* frame; // nullptr = no hero drawn
+        const AnimFrameRef* clip; // Animation::frame_refs it was drawn from
+        int clip_frame;
+        int x, y;
+    };
+    bool drawn_valid; // false: the next frame redraws everything
+    HeroDraw drawn_hero;
 
     // --- Private Helper Methods ---
     void handleInput();
-    void update(Uint32 currentTime); // Pass current time from loop
+    void update(uint32_t currentTime); // Pass current time from loop
     void render();
-
-    void drawClippedTile(int dest_x_unclipped, const uint16_t* tile_data,
-                         int layer_tile_width, int layer_tile_height);
-    void setupAnimations();
-    void selectActiveAnimation(bool forceReset);
+    bool animatesEveryFrame() const;
+    uint32_t frameIntervalMs() const; // Frame cadence at the current quality level
+    void applyQuality();
+    uint32_t msUntilNextChange(uint32_t now) const;
+    void logLoopStats(uint32_t now);
+    void notePresented(uint32_t submitted);
+    void showFrame(uint32_t submitted);
+    void pinCharacter(DigimonType digimon);
+    void releaseCharacter(DigimonType digimon);
+    void unpinShownCharacters();
+
+    bool loadScenes();
+    void selectScene(size_t index);
+    void logFrameStats();
+    bool recordDamage(bool scene_moved, const HeroDraw& hero);
+    void selectActiveAnimation(bool forceReset, uint32_t startTime);
+    void requestDigimon(DigimonType digimon);
+    void completePendingSwitch();
+    void setCrowdMode(bool enabled, uint32_t currentTime);
+    void spawnCrowd(uint32_t currentTime);
+    void releaseCrowdAssets();
+    void updateCrowd(uint32_t currentTime, float steps);
 
     // --- Constants (copied from old main) ---
     const int WINDOW_WIDTH = 466;
     const int WINDOW_HEIGHT = 466;
-    const int MAX_QUEUED_STEPS = 2;
-
-    const int TILE_WIDTH_0 = CASTLEBACKGROUND0_WIDTH;
-    const int TILE_HEIGHT_0 = CASTLEBACKGROUND0_HEIGHT;
-    const int EFFECTIVE_BG_WIDTH_0 = 947;
-    const float effectiveW_float_0 = static_cast<float>(EFFECTIVE_BG_WIDTH_0);
-    const float SCROLL_SPEED_0 = 3.0f;
-
-    const int TILE_WIDTH_1 = CASTLEBACKGROUND1_WIDTH;
-    const int TILE_HEIGHT_1 = CASTLEBACKGROUND1_HEIGHT;
-    const int EFFECTIVE_BG_WIDTH_1 = 947;
-    const float effectiveW_float_1 = static_cast<float>(EFFECTIVE_BG_WIDTH_1);
-    const float SCROLL_SPEED_1 = 1.0f;
-
-    const int TILE_WIDTH_2 = CASTLEBACKGROUND2_WIDTH;
-    const int TILE_HEIGHT_2 = CASTLEBACKGROUND2_HEIGHT;
-    const int EFFECTIVE_BG_WIDTH_2 = 947;
-    const float effectiveW_float_2 = static_cast<float>(EFFECTIVE_BG_WIDTH_2);
-    const float SCROLL_SPEED_2 = 0.5f;
+    const int MAX_QUEUED_STEPS = 2; // Walk cycles owed at most; further steps are dropped
+    const size_t ASSET_CACHE_BUDGET_BYTES = 2304 * 1024; // Current Digimon plus both neighbours
+    const uint32_t STATS_LOG_INTERVAL_FRAMES = 300; // ~5 s at 60 FPS
+    const uint32_t FRAME_INTERVAL_MS = 16; // Frame cadence while something moves every frame (~60 FPS)
+    const uint32_t LOOP_STATS_INTERVAL_MS = 10000;
+    const int CROWD_SPRITE_MARGIN = 96; // Half a sprite: walkers leave the screen fully before wrapping
 };
 
 #endif // GAME_H
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef GAME_CLOCK_H
+#define GAME_CLOCK_H
+
+#include <SDL_timer.h>
+#include <stdint.h>
+
+// Game time in milliseconds, for everything that decides what a frame shows.
+// Real: SDL_GetTicks(), and sleep() sleeps. Virtual: starts at 0 and moves only when slept,
+// instantly, so a run fed by recorded input (ReplayInput) is the same run every time and
+// goes as fast as the frames can be drawn.
+class GameClock {
+public:
+    explicit GameClock(bool virtual_time = false) : is_virtual(virtual_time), virtual_now(0) {}
+
+    uint32_t now() const { return is_virtual ? virtual_now : SDL_GetTicks(); }
+    void sleep(uint32_t ms) {
+        if (is_virtual) virtual_now += ms;
+        else SDL_Delay(ms);
+    }
+    bool isVirtual() const { return is_virtual; }
+
+private:
+    bool is_virtual;
+    uint32_t virtual_now;
+};
+
+#endif // GAME_CLOCK_H
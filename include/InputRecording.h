@@ -0,0 +1,59 @@
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include "platform/IInput.h" // InputState
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+// Recorded input: the frames whose InputState had an edge, timed in ms since the first
+// update() of the session, and when the session ended.
+//
+// File format (little-endian, variable-length unsigned integers: 7 bits a byte, low first,
+// high bit = more follow):
+//   "DGIN"  version (1 byte)  action count (1 byte, INPUT_ACTION_COUNT when written)
+//   per frame:  time since the previous entry, pressed, released, held, steps
+//   end:        time since the previous entry, 0, 0, 0, 0    (no frame has neither edge)
+// 'steps' is stepsPressed(): a pedometer can bring several in the frame with one STEP press.
+// Version 1 files have no steps field; their steps are 1 wherever STEP was pressed.
+// A key tap costs about 10 bytes; an hour of play is a few KB.
+struct InputRecord {
+    uint32_t time_ms;
+    InputState state;
+    uint32_t steps;
+};
+
+struct InputRecording {
+    std::vector<InputRecord> frames; // In time order
+    uint32_t end_ms = 0;
+};
+
+// Loads a recording; false (logged) if it can't be read or was made with other actions
+bool loadInputRecording(const char* path, InputRecording& recording);
+
+// Writes a session's input as it happens. record() every update(), finish() at the end;
+// nothing is buffered beyond stdio's, so a crash loses at most the end marker.
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder(); // finish()es at the last recorded time if still open
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    bool open(const char* path); // Logged on failure
+    bool isOpen() const { return file != nullptr; }
+    void record(uint32_t now_ms, const InputState& state, uint32_t steps); // The first call starts the session clock
+    void finish(uint32_t now_ms);                                          // Writes the end marker and closes
+    uint32_t framesRecorded() const { return frames; }
+
+private:
+    void writeEntry(uint32_t now_ms, const InputState& state, uint32_t steps);
+
+    FILE* file;
+    bool started;
+    uint32_t start_ms, last_ms;
+    uint32_t frames;
+};
+
+#endif // INPUT_RECORDING_H
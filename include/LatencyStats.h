@@ -0,0 +1,32 @@
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct LatencySummary {
+    size_t count; // Samples summarised
+    double p50, p95, p99, max;
+};
+
+// The most recent WINDOW latency samples in a fixed ring (recording never allocates), with
+// nearest-rank percentiles over them for periodic stats output.
+class LatencyStats {
+public:
+    static const size_t WINDOW = 256;
+
+    LatencyStats();
+
+    void add(double ms);
+    void reset();
+    uint64_t total() const { return added; } // Samples since construction/reset, including ones rotated out
+    LatencySummary summary() const;          // All zero if there are no samples
+
+private:
+    double samples[WINDOW];
+    size_t next; // Ring position of the next sample
+    size_t held; // Up to WINDOW
+    uint64_t added;
+};
+
+#endif // LATENCY_STATS_H
@@ -0,0 +1,47 @@
+#ifndef LAYER_CACHE_H
+#define LAYER_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "Blitter.h" // PixelFormat
+
+// A horizontally repeating background tile kept resident in a display's pixel format.
+//
+// The tile's columns repeat every 'period' (its art past the period duplicates the start),
+// so the cache is a ring one period wide: tile column c lives in ring column c % period.
+// Art that doesn't actually repeat is cached whole instead (period = width).
+// Ring columns are converted from the RGB565 art the first time they're shown, so a
+// scrolling layer pays for each column once; after that, drawing it is a straight copy and
+// scrolling only moves the read offset.
+class LayerCache {
+public:
+    LayerCache(const uint16_t* art, int width, int height, int period);
+
+    // Makes the ring columns behind tile columns [x0, x1) resident in 'format', converting only
+    // the missing ones (a format change starts over). Returns the number of columns converted.
+    int prepare(int x0, int x1, PixelFormat format);
+
+    // Ring pixel for tile column x (any x >= 0) on row y; valid once prepared
+    const void* pixelAt(int x, int y) const;
+    // Columns from tile column x to the end of the ring (copies must be split there)
+    int columnsUntilWrap(int x) const { return period - x % period; }
+    PixelFormat format() const { return pixel_format; }
+    // Same art size and (resolved) period: either cache serves the other's blits the same way
+    bool sameLayout(const LayerCache& other) const {
+        return width == other.width && height == other.height && period == other.period;
+    }
+    size_t memoryBytes() const { return ring.capacity() + resident.capacity(); }
+
+private:
+    void convert(int ring_x0, int ring_x1);
+
+    const uint16_t* art;
+    int width, height, period;
+    PixelFormat pixel_format;
+    std::vector<uint8_t> ring;     // period x height pixels in pixel_format
+    std::vector<uint8_t> resident; // Per ring column
+};
+
+#endif // LAYER_CACHE_H
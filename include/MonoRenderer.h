@@ -0,0 +1,75 @@
+#ifndef MONO_RENDERER_H
+#define MONO_RENDERER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "SourceKey.h"
+
+class DrawList;
+struct DrawCommand;
+
+// One machine word of 1bpp pixels, leftmost pixel in the lowest bit.
+// DIGIVICE_MONO_WORD32 selects 32-pixel words (32-bit MCUs); the default is 64.
+#ifdef DIGIVICE_MONO_WORD32
+typedef uint32_t MonoWord;
+#else
+typedef uint64_t MonoWord;
+#endif
+const int MONO_WORD_BITS = static_cast<int>(sizeof(MonoWord) * 8);
+
+// A 1bpp bit-plane image. 'ink' bits are dark dots; 'mask' bits are where the image covers
+// (its colour-key pixels are 0). Rows are padded with one spare zero word for unaligned reads.
+struct MonoPlane {
+    int width = 0, height = 0;
+    int words_per_row = 0; // Including the spare word
+    bool opaque = false;   // Every mask bit inside the image is set
+    std::vector<MonoWord> ink, mask;
+};
+
+// Derives a bit plane from RGB565 art at 1/downscale resolution: a dot is covered if at least
+// half of its source block is, and inked by ordered (4x4 Bayer) dithering of the block's
+// average luminance, so flat colours turn into stable patterns that scroll with the art.
+// 'flip_x' derives the mirror image.
+MonoPlane makeMonoPlane(const uint16_t* pixels, int width, int height, int downscale, bool flip_x);
+
+// Draws recorded frames for monochrome dot-matrix LCDs: a 1bpp framebuffer at 1/downscale of
+// the logical screen, composited a word (32 or 64 dots) at a time with AND/OR masks:
+//   dst = (dst & ~mask) | (ink & mask)
+// Bit planes are derived from each RGB565 source on first use and cached by its pixel pointer
+// and size, so sources must not change while in use, and must be forgetSource()d before they
+// are freed (a new image at the same address would get their planes).
+class MonoRenderer {
+public:
+    explicit MonoRenderer(int downscale = 4);
+
+    // Allocates the LCD framebuffer for a (width x height) logical screen
+    bool init(int logical_width, int logical_height);
+    void clear(uint16_t color); // Dark if the colour is
+    void drawCommand(const DrawCommand& cmd);
+    void submit(DrawList& list); // Layer sort, occlusion cull, clear, then every command
+    void forgetSource(const uint16_t* pixels); // Drops the planes derived from 'pixels'
+
+    const MonoWord* frame() const { return framebuffer.data(); }
+    int width() const { return lcd_width; }
+    int height() const { return lcd_height; }
+    int wordsPerRow() const { return words_per_row; }
+    bool dot(int x, int y) const {
+        return (framebuffer[static_cast<size_t>(y) * words_per_row + x / MONO_WORD_BITS] >> (x % MONO_WORD_BITS)) & 1;
+    }
+    uint64_t wordsWritten() const { return words_written; } // Since init(): the backend's whole workload
+    size_t planeBytes() const; // Derived planes held in the cache
+
+private:
+    const MonoPlane& planeFor(const DrawCommand& cmd, bool flip_x);
+
+    int downscale;
+    int lcd_width, lcd_height, words_per_row;
+    std::vector<MonoWord> framebuffer;
+    std::unordered_map<SourceKey, MonoPlane, SourceKeyHash> planes, mirrored_planes;
+    uint64_t words_written;
+};
+
+#endif // MONO_RENDERER_H
@@ -0,0 +1,84 @@
+#ifndef PARALLAX_SCENE_H
+#define PARALLAX_SCENE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class DrawList;
+
+// Art a scene can refer to by name: compiled-in, or read from a raw RGB565 file
+struct SceneImage {
+    const char* name;
+    const uint16_t* pixels;
+    int width, height;
+};
+
+// One scrolling layer of a scene
+struct SceneLayer {
+    std::string name;
+    const uint16_t* pixels;
+    int width, height;
+    int wrap;      // The art repeats every 'wrap' columns (its width if it doesn't)
+    float speed;   // Pixels per scroll() frame
+    int y;         // Top edge on screen
+    int z;         // Depth: lower is further back
+    uint8_t flags; // DRAW_OPAQUE if the art has no transparent pixels, else DRAW_COLOR_KEY
+    float offset;  // Scroll position in [0, wrap)
+};
+
+// A parallax backdrop described by a text file and loaded at runtime, so scenes can be
+// added or edited without rebuilding. One directive per line, '#' starts a comment:
+//
+//   clear <rgb565>                              Colour wherever no layer covers (default 0x0000)
+//   image <name> <file> <width> <height>        Raw little-endian RGB565 art, relative to the scene file
+//   layer <name> <image> [speed <px/frame>] [wrap <px>] [y <px>] [z <n>]
+//   sprites <z>                                 Depth of the characters: layers below it go behind them
+//
+// Images can also name the compiled-in art passed to load(). Layers are drawn by z, file
+// order breaking ties, and each gets its own DrawList layer.
+class ParallaxScene {
+public:
+    static constexpr size_t MAX_LAYERS = 32;
+
+    ParallaxScene();
+
+    // Replaces the scene; on failure returns false, keeps nothing and explains in error()
+    bool load(const char* path, const SceneImage* builtin, size_t builtin_count);
+    bool parse(const char* text, const char* origin, const char* base_dir,
+               const SceneImage* builtin, size_t builtin_count);
+    const std::string& error() const { return last_error; }
+
+    // Advances every layer by speed * frames, wrapping
+    void scroll(float frames);
+    // Records the layers that reach the viewport, one tile per visible period. Returns true if
+    // anything is drawn somewhere else than by the previous record().
+    // With far layers hidden (quality governor), only the nearest layer behind the characters
+    // and those in front of them are recorded; the clear colour shows through instead.
+    bool record(DrawList& list, int viewport_width, int viewport_height);
+    // Most blits record() can add at this width: two per layer unless its period is narrower
+    size_t maxBlits(int viewport_width) const;
+
+    const std::string& name() const { return scene_name; }
+    size_t layerCount() const { return layers.size(); }
+    const SceneLayer& layer(size_t i) const { return layers[i]; }
+    uint8_t drawLayer(size_t i) const { return static_cast<uint8_t>(i < sprites_behind ? i : i + 1); }
+    uint8_t spriteLayer() const { return static_cast<uint8_t>(sprites_behind); }
+    uint16_t clearColor() const { return clear_color; }
+    void setFarLayersHidden(bool hidden) { far_layers_hidden = hidden; }
+
+private:
+    bool fail(const char* origin, int line, const std::string& message);
+
+    std::string scene_name;
+    std::vector<SceneLayer> layers; // Sorted back to front
+    std::vector<std::vector<uint16_t>> file_images; // Pixels of 'image' art, owned
+    std::vector<int> drawn_x;       // Each layer's first tile position at the last record()
+    size_t sprites_behind;          // Layers drawn before the characters
+    uint16_t clear_color;
+    bool far_layers_hidden;
+    std::string last_error;
+};
+
+#endif // PARALLAX_SCENE_H
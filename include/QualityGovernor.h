@@ -0,0 +1,43 @@
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+#include <stdint.h>
+
+// Rendering quality steps, cheapest last. Each level keeps the savings of the ones above it.
+enum QualityLevel {
+    QUALITY_FULL,             // Every layer, every frame, every row
+    QUALITY_NO_FAR_LAYERS,    // Scene layers behind the nearest background layer are skipped
+    QUALITY_HALF_FRAME_RATE,  // Half as many frames; animations drop their in-between frames
+    QUALITY_HALF_RESOLUTION,  // Every other row is composed and repeated below
+    QUALITY_LEVEL_COUNT
+};
+
+const char* qualityLevelName(QualityLevel level);
+
+// Keeps frame time within budget on slow hardware. Fed each frame's work time against the
+// time it had (its frame interval), it averages the load over a window of frames and steps
+// down a level when the frames overrun, or back up once the load is so low that the level
+// above would still fit. Every decision starts a fresh window, so a step is judged only by
+// frames drawn at the new level.
+class QualityGovernor {
+public:
+    // Step down above 'high' load, up below 'low' (fractions of the frame interval). 'low'
+    // should be under high / 2: stepping up can double the work.
+    explicit QualityGovernor(float high = 0.9f, float low = 0.4f, uint32_t window_frames = 30);
+
+    // Adds a frame that took 'work_ms' out of 'interval_ms'; true if the level changed
+    bool addFrame(float work_ms, float interval_ms);
+
+    QualityLevel level() const { return current; }
+    float lastLoad() const { return last_load; } // Average load of the window behind the last change
+
+private:
+    float high_load, low_load;
+    uint32_t window;
+    QualityLevel current;
+    uint32_t frames;
+    float work_sum, interval_sum;
+    float last_load;
+};
+
+#endif // QUALITY_GOVERNOR_H
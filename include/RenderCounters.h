@@ -0,0 +1,35 @@
+#ifndef RENDER_COUNTERS_H
+#define RENDER_COUNTERS_H
+
+#include <stdint.h>
+
+const int RENDER_STATS_LAYERS = 8; // Layers >= this are counted in the last slot
+
+inline int renderStatsSlot(int layer) { return layer < RENDER_STATS_LAYERS ? layer : RENDER_STATS_LAYERS - 1; }
+
+// Memory traffic of one rendered frame, per draw layer where it has one
+struct RenderCounters {
+    uint32_t blits[RENDER_STATS_LAYERS];          // Blits that reached the target
+    uint64_t pixels_read[RENDER_STATS_LAYERS];    // Source pixels fetched
+    uint64_t pixels_written[RENDER_STATS_LAYERS]; // Target pixels stored from a source
+    uint64_t pixels_cleared;                      // Target pixels stored with the clear colour
+    uint64_t bytes_uploaded;                      // Framebuffer bytes handed to the GPU (or panel)
+    uint32_t texture_locks;                       // Streaming texture lock/unlock pairs
+
+    uint64_t totalRead() const;
+    uint64_t totalWritten() const; // Including cleared pixels
+};
+
+inline uint64_t RenderCounters::totalRead() const {
+    uint64_t total = 0;
+    for (int i = 0; i < RENDER_STATS_LAYERS; ++i) total += pixels_read[i];
+    return total;
+}
+
+inline uint64_t RenderCounters::totalWritten() const {
+    uint64_t total = pixels_cleared;
+    for (int i = 0; i < RENDER_STATS_LAYERS; ++i) total += pixels_written[i];
+    return total;
+}
+
+#endif // RENDER_COUNTERS_H
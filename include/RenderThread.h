@@ -0,0 +1,111 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SoftwareRenderer.h"
+#include "TripleBuffer.h"
+#include "platform/DrawList.h"
+
+// What the game thread hands over for one frame: a copy it never touches again
+struct RenderSnapshot {
+    DrawList list{0};
+    bool heat_map = false;
+    int row_step = 1;           // ScanlineCompositor::setRowStep
+    uint64_t sequence = 0;      // 1, 2, 3... in submit() order
+    uint64_t submitted_ns = 0;  // renderClockNs() at submit()
+};
+
+// A frame the render thread finished drawing
+struct RenderedFrame {
+    std::vector<uint8_t> pixels; // width x height, rows packed
+    int width = 0, height = 0;
+    PixelFormat format = PixelFormat::RGB565;
+    uint64_t sequence = 0;      // Of the snapshot it was drawn from
+    uint64_t submitted_ns = 0;  // ... and when that was submitted
+    uint64_t finished_ns = 0;   // When drawing finished
+    RenderCounters counters = {};
+    CompositorStats stats = {};
+    bool composited = false;    // 'stats' are valid (heat-map frames are drawn without the compositor)
+};
+
+// Where finished frames go. Both calls run on the render thread, one frame at a time.
+class FrameSink {
+public:
+    virtual ~FrameSink() = default;
+    // Before the frame is published, while only the render thread sees it: e.g. a panel transfer
+    virtual void presentFrame(const RenderedFrame& /*frame*/) {}
+    // After: RenderThread::latestFrame() now returns it (e.g. wake the thread that shows frames)
+    virtual void frameReady() {}
+};
+
+uint64_t renderClockNs(); // Monotonic clock the snapshot/frame timestamps use
+
+// Moves compositing off the game thread. submit() copies the frame's DrawList into a snapshot
+// triple buffer; the render thread draws the newest snapshot into a frame from a second triple
+// buffer and publishes it for latestFrame(). Neither side waits for the other: snapshots the
+// renderer didn't get to are replaced by newer ones (counted as dropped), and so are finished
+// frames nobody took. The render thread sleeps only while there is nothing to draw.
+//
+// Frames are always drawn in full: a dropped snapshot's damage rect would otherwise be lost.
+// The compositor belongs to the render thread once it runs, so layer caches are declared first.
+class RenderThread {
+public:
+    RenderThread();
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Sizes the frames and starts the thread; 'sink' (optional) must outlive it
+    bool start(int width, int height, PixelFormat format, FrameSink* sink);
+    void stop(); // Finishes the frame being drawn and joins the thread
+    bool running() const { return worker.joinable(); }
+
+    // Before start() only (see ScanlineCompositor::cacheLayer); ignored once running
+    bool cacheLayer(const uint16_t* art, int width, int height, int period);
+
+    // --- Game thread ---
+    void submit(const DrawList& list, bool heat_map, int row_step);
+    // A source image is about to be freed: its cached spans go before the render thread draws
+    // any snapshot submitted after this call
+    void forgetSource(const uint16_t* pixels);
+
+    // --- Display thread ---
+    // The newest finished frame if one was published since the last call, else nullptr.
+    // Valid until the next call.
+    const RenderedFrame* latestFrame();
+    bool framePending() const { return frames.pending(); }
+
+    // Counters (any thread)
+    uint64_t submitted() const { return submitted_count.load(std::memory_order_relaxed); }
+    uint64_t drawn() const { return drawn_count.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_count.load(std::memory_order_relaxed); } // Snapshots never drawn
+
+private:
+    void renderLoop();
+
+    SoftwareRenderer software; // Render thread's once started
+    FrameSink* sink;
+    TripleBuffer<RenderSnapshot> snapshots;
+    TripleBuffer<RenderedFrame> frames;
+    uint64_t next_sequence;  // Game thread's
+    uint64_t last_drawn;     // Render thread's: sequence of the last snapshot drawn
+
+    std::atomic<uint64_t> submitted_count, drawn_count, dropped_count;
+    // Only for the render thread's sleep while there is nothing to draw, and the forget list
+    std::mutex mutex;
+    std::condition_variable work;
+    bool stopping; // Guarded by 'mutex'
+    std::vector<const uint16_t*> forgotten;  // Guarded by 'mutex': forgetSource() calls not applied yet
+    std::vector<const uint16_t*> forgetting; // Render thread's: the batch being applied
+    std::thread worker;
+};
+
+#endif // RENDER_THREAD_H
@@ -0,0 +1,102 @@
+#ifndef SCANLINE_COMPOSITOR_H
+#define SCANLINE_COMPOSITOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "Blitter.h"
+#include "LayerCache.h"
+#include "RenderCounters.h" // RENDER_STATS_LAYERS
+#include "SourceKey.h"
+
+class DrawList;
+struct DrawCommand;
+
+// Per-frame counters (and coverage report) from the last compose()
+struct CompositorStats {
+    uint64_t pixels;         // Target pixels (width * height)
+    uint64_t layers_touched; // Sum over pixels of the blits consulted before the pixel was resolved
+    uint64_t painter_writes; // Pixels the painter's algorithm would have written (sum of visible blit areas)
+    uint64_t pixels_written; // Pixels written from a source (each at most once)
+    uint64_t pixels_cleared; // Pixels no blit covered, filled with the clear colour
+    uint64_t pixels_hidden;  // Blit pixels skipped because an opaque span in front already covered them
+    uint32_t blits_culled;   // Whole blits dropped behind a DRAW_OPAQUE blit
+    uint32_t columns_converted; // Layer cache columns converted to the target format
+    uint64_t layer_written[RENDER_STATS_LAYERS]; // Final pixels each layer supplied
+
+    double layersTouchedPerPixel() const { return pixels ? static_cast<double>(layers_touched) / pixels : 0.0; }
+    double painterLayersPerPixel() const { return pixels ? static_cast<double>(painter_writes) / pixels : 0.0; }
+    double coverage(uint64_t count) const { return pixels ? 100.0 * count / pixels : 0.0; } // Percent of the target
+};
+
+// Renders a DrawList one output row at a time, PPU style: for each row the blits on it are
+// walked front to back, and each contributes only its opaque spans that nothing in front of it
+// has already covered. Every target pixel is written exactly once (sources or the clear
+// colour) and each write pays for one format conversion. Nothing is cleared that a blit covers,
+// and back-layer pixels behind opaque spans are never read.
+//
+// Opaque spans are computed once per source image (keyed by its pixel pointer and size) and
+// cached, so sources must not change while they're in use. Sources that get freed (evicted
+// assets) must be forget()ten first, or a new image at the same address gets their spans.
+// Sources registered with cacheLayer() are also kept converted to the target's format, so
+// on targets other than RGB565 the backgrounds are copied rather than converted every frame.
+class ScanlineCompositor {
+public:
+    ScanlineCompositor() = default;
+
+    void compose(DrawList& list, const BlitSurface& target);
+    // The same, a strip at a time (strip renderers): begin() prepares a (width x height) frame,
+    // then composeRows() renders rows [first_row, first_row + strip.height) into 'strip', whose
+    // row 0 is first_row. Strips go top to bottom, each once; 'list' must not change in between.
+    void begin(DrawList& list, int width, int height, PixelFormat format);
+    void composeRows(const DrawList& list, const BlitSurface& strip, int first_row);
+    // Lower vertical resolution under load: only every step-th row (and each strip's first) is
+    // composed, the rows below it repeat it. 1 = every row. Counters cover the composed rows only.
+    // Rows are counted on the whole target (DrawList::originY()), so a cropped redraw repeats
+    // the same rows as a full one.
+    void setRowStep(int step) { row_step = step > 1 ? step : 1; }
+    int rowStep() const { return row_step; }
+    // Heap bytes held by the span/layer caches and per-frame scratch (memory budget reports)
+    size_t memoryBytes() const;
+    // Declares a repeating background tile (see LayerCache); it is cached on first use. Returns
+    // false if 'art' was already declared with another size or period: the first declaration
+    // stays (LayerCache checks the art really repeats, so it draws the same either way).
+    bool cacheLayer(const uint16_t* art, int width, int height, int period);
+    // Drops the span tables derived from a source image that is about to be freed
+    void forget(const uint16_t* pixels);
+    const CompositorStats& stats() const { return frame_stats; }
+
+private:
+    struct Interval { int start, end; }; // [start, end)
+    struct SpanTable {
+        std::vector<uint32_t> row_start; // Index of each source row's first span (+1 sentinel)
+        std::vector<Interval> spans;     // Non-key runs, source columns
+    };
+
+    const SpanTable& spansFor(const DrawCommand& cmd);
+    void bucketByRow(const DrawList& list, int height);
+    void composeRow(const DrawList& list, const BlitSurface& target, int y, int target_row);
+    void buildRuns(const DrawCommand& cmd, const SpanTable* table, int source_row, int x0, int x1);
+
+    std::unordered_map<SourceKey, SpanTable, SourceKeyHash> span_cache;
+    std::unordered_map<const uint16_t*, LayerCache> layer_caches;
+    CompositorStats frame_stats = {};
+    int frame_width = 0, frame_height = 0;
+    int next_row = 0; // First row the next composeRows() must start at
+    int row_step = 1;
+    int origin_y = 0; // DrawList::originY() of the frame being composed
+
+    // Per-frame scratch, reused (grows only)
+    std::vector<uint32_t> row_first;  // Start of each row's bucket in 'by_row' (+1 sentinel)
+    std::vector<uint32_t> row_cursor;
+    std::vector<uint32_t> by_row;     // Command indices ordered by first visible row
+    std::vector<uint32_t> active, active_next; // Commands on the current row, in draw order
+    std::vector<Interval> rows, columns;       // Visible target rows/columns of each command
+    std::vector<const SpanTable*> tables;      // Span table per command (nullptr = opaque)
+    std::vector<const LayerCache*> caches;     // Converted source per command (nullptr = read the art)
+    std::vector<Interval> uncovered, uncovered_next, runs;
+};
+
+#endif // SCANLINE_COMPOSITOR_H
@@ -0,0 +1,61 @@
+#ifndef SOFTWARE_RENDERER_H
+#define SOFTWARE_RENDERER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "Blitter.h"
+#include "RenderCounters.h"
+#include "ScanlineCompositor.h"
+
+class DrawList;
+struct DrawCommand;
+
+// The drawing half of the software display backends: executes draws into a caller-owned
+// surface and keeps the per-frame RenderCounters. The backend owns the surface and tells
+// the renderer about texture locks and uploads, then closes each frame with endFrame().
+//
+// Heat-map mode (debug): submit() draws with the painter's algorithm instead of the
+// compositor, counts how many times each pixel is stored, and tints the finished frame
+// by that count (blue 1, green 2, yellow 3, orange 4, red 5+).
+class SoftwareRenderer {
+public:
+    SoftwareRenderer() = default;
+
+    void clear(const BlitSurface& target, uint16_t color);
+    void drawCommand(const BlitSurface& target, const DrawCommand& cmd);
+    // Immediate colour-keyed blit; it has no layer and is counted as layer 0
+    void drawPixels(const BlitSurface& target, int dest_x, int dest_y, int width, int height,
+                    const uint16_t* pixels, int source_width, int source_height, int source_x, int source_y);
+    void submit(const BlitSurface& target, DrawList& list);
+
+    bool cacheLayer(const uint16_t* art, int width, int height, int period) { return compositor.cacheLayer(art, width, height, period); }
+    void forgetSource(const uint16_t* pixels) { compositor.forget(pixels); } // See ScanlineCompositor::forget
+
+    void countTextureLock() { frame.texture_locks++; }
+    // Closes the frame: its counters become counters() and a new frame starts at zero
+    void endFrame(uint64_t bytes_uploaded);
+
+    void setRowStep(int step) { compositor.setRowStep(step); } // See ScanlineCompositor::setRowStep
+    void setHeatMap(bool enabled) { heat_map = enabled; }
+    bool heatMap() const { return heat_map; }
+
+    const RenderCounters& counters() const { return last_frame; } // Last completed frame
+    // Last submit()'s compositor counters; nullptr in heat-map mode (the compositor doesn't run)
+    const CompositorStats* compositorStats() const { return heat_map ? nullptr : &compositor.stats(); }
+
+private:
+    void countCommand(const BlitSurface& target, const DrawCommand& cmd, int visited);
+    void applyHeatMap(const BlitSurface& target);
+
+    ScanlineCompositor compositor;
+    RenderCounters frame = {};
+    RenderCounters last_frame = {};
+    bool heat_map = false;
+    std::vector<uint8_t> store_counts; // Heat map: stores per target pixel this frame
+};
+
+// Adds a composited frame (ScanlineCompositor) to 'counters'
+void countComposited(RenderCounters& counters, const CompositorStats& stats, const DrawList& list);
+
+#endif // SOFTWARE_RENDERER_H
@@ -0,0 +1,26 @@
+#ifndef SOURCE_KEY_H
+#define SOURCE_KEY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+// Identifies a source image for caches of data derived from it (span tables, bit planes).
+// The size is part of the key: a freed image's address can come back for another image, and
+// the owner says when one is freed (IDisplay::forgetSource) so its entries can go.
+struct SourceKey {
+    const uint16_t* pixels;
+    int width, height;
+
+    bool operator==(const SourceKey& other) const {
+        return pixels == other.pixels && width == other.width && height == other.height;
+    }
+};
+
+struct SourceKeyHash {
+    size_t operator()(const SourceKey& key) const {
+        return std::hash<const void*>()(key.pixels) ^ (static_cast<size_t>(key.width) * 31 + static_cast<size_t>(key.height));
+    }
+};
+
+#endif // SOURCE_KEY_H
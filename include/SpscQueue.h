@@ -0,0 +1,47 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <stddef.h>
+
+// Lock-free single-producer/single-consumer FIFO of up to CAPACITY values in a fixed ring:
+// one thread push()es, one pop()s, and nothing allocates after construction. A full queue
+// refuses the push rather than overwrite (the producer decides what dropping means).
+template <typename T, size_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer: false if full
+    bool push(const T& value) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == CAPACITY) return false;
+        ring[t & (CAPACITY - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: false if empty
+    bool pop(T& value) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        value = ring[h & (CAPACITY - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+private:
+    T ring[CAPACITY];
+    // Free-running counters; on their own cache lines so the two threads don't share one
+    alignas(64) std::atomic<size_t> head; // Next to pop (consumer's)
+    alignas(64) std::atomic<size_t> tail; // Next to push (producer's)
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,92 @@
+#ifndef STEP_DETECTOR_H
+#define STEP_DETECTOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// One 3-axis accelerometer reading in milli-g (1000 = 1 g), the unit most MEMS parts report
+// in once scaled; int16 covers +-32 g
+struct AccelSample {
+    int16_t x, y, z;
+};
+
+enum StepEventType : uint8_t {
+    STEP_EVENT_STEP,    // A step, timed at its acceleration peak
+    STEP_EVENT_CADENCE, // The cadence changed (0 = stopped walking)
+};
+
+struct StepEvent {
+    StepEventType type;
+    uint16_t cadence; // Steps per minute after this event, 0 = not walking / not known yet
+    uint32_t time_ms; // Sample time since the detector started (or was reset)
+};
+
+// Streaming pedometer: raw samples in, step and cadence events out, in batches, integer
+// arithmetic only and nothing allocated after construction. Per sample:
+//
+//   |a|      integer square root of x^2 + y^2 + z^2 (orientation doesn't matter)
+//   - g      minus a ~1 s moving average of |a|: gravity and sensor offset out
+//   smooth   two one-pole low-passes at ~4 Hz: hand tremor and impact ringing out
+//   peaks    a step is a peak above an adaptive threshold (half the recent peak height, never
+//            below a noise floor) that ends with the signal dropping back under zero; peaks
+//            closer than 250 ms to the last step are the same step (max 240 steps/min)
+//
+// Cadence is 60 s over the average of the last few step intervals. It is reported (as a
+// cadence event) when it moves by 3 steps/min or more, and as 0 once no step has come for 2 s.
+// Filter coefficients are Q16 fractions worked out once for the sample rate (50-1000 Hz);
+// filter state is Q8 milli-g.
+class StepDetector {
+public:
+    static const int MIN_RATE_HZ = 50;
+    static const int MAX_RATE_HZ = 1000;
+
+    explicit StepDetector(int rate_hz = 100); // Clamped to MIN/MAX_RATE_HZ
+
+    // Runs 'count' samples through the pipeline and writes up to 'max_events' events; returns
+    // how many were written. Events past 'max_events' are counted in eventsDropped().
+    size_t process(const AccelSample* samples, size_t count, StepEvent* events, size_t max_events);
+    void reset(); // Back to the state after construction, keeping the rate
+
+    int rateHz() const { return rate; }
+    uint32_t steps() const { return step_count; }
+    uint16_t cadence() const { return current_cadence; }
+    uint64_t samplesProcessed() const { return sample_index; }
+    uint32_t eventsDropped() const { return events_dropped; }
+
+private:
+    static const int32_t NOISE_FLOOR = 60; // milli-g: smaller peaks are never steps
+    static const uint16_t CADENCE_EVENT_DELTA = 3; // steps/min
+    static const int INTERVAL_HISTORY = 8;          // Step intervals averaged into the cadence
+
+    void step(int32_t signal_q8, StepEvent* events, size_t max_events, size_t& written);
+    void emit(StepEventType type, uint64_t at_sample, StepEvent* events, size_t max_events, size_t& written);
+
+    int rate;
+    // Coefficients (Q16) and intervals in samples, from the rate
+    int32_t gravity_alpha, smooth_alpha;
+    uint32_t min_step_samples, max_step_samples;
+
+    // Filter state (Q8 milli-g)
+    int32_t gravity_q8;
+    int32_t smooth1_q8, smooth2_q8;
+    bool primed; // gravity_q8 holds a real estimate
+
+    // Peak tracking
+    bool in_peak;
+    int32_t peak_q8;
+    uint64_t peak_sample;
+    int32_t peak_level_q8; // Moving average of accepted peak heights
+
+    // Steps and cadence
+    uint64_t sample_index;
+    uint64_t last_step_sample;
+    uint32_t step_count;
+    uint32_t intervals[INTERVAL_HISTORY];
+    int interval_count; // Valid entries in 'intervals', up to INTERVAL_HISTORY
+    int interval_next;
+    uint16_t current_cadence;
+    uint16_t reported_cadence;
+    uint32_t events_dropped;
+};
+
+#endif // STEP_DETECTOR_H
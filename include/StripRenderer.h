@@ -0,0 +1,83 @@
+#ifndef STRIP_RENDERER_H
+#define STRIP_RENDERER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ScanlineCompositor.h"
+#include "platform/DrawList.h" // DrawRect
+
+// Where finished strips go: the panel link of a strip-rendering backend
+class StripSink {
+public:
+    virtual ~StripSink() = default;
+    // Sends one finished strip: 'area' is its place on screen, 'pixels' area.w x area.h RGB565,
+    // rows packed. Runs on the flush thread, one strip at a time, in screen order.
+    virtual void flushStrip(const DrawRect& area, const uint16_t* pixels) = 0;
+};
+
+struct StripStats {
+    uint32_t strips;  // Strips rendered last frame
+    uint64_t busy_ns; // Compositing time
+    uint64_t wait_ns; // Time the compositor stalled waiting for a strip buffer to finish flushing
+};
+
+// Renders frames without a framebuffer, for targets whose RAM can't hold one (466x466 RGB565
+// is 434 KB). The scanline compositor fills a strip of a few rows at a time into one of two
+// small RGB565 buffers; a finished strip goes to a flush thread (standing in for the SPI DMA
+// channel) that hands it to the StripSink, while the next strip renders into the other buffer.
+//
+// Each frame's memory is the two strip buffers plus the compositor's span tables and scratch.
+class StripRenderer {
+public:
+    StripRenderer();
+    ~StripRenderer();
+
+    StripRenderer(const StripRenderer&) = delete;
+    StripRenderer& operator=(const StripRenderer&) = delete;
+
+    // Allocates the strip buffers for rows up to 'max_width' wide and starts the flush thread
+    bool init(int max_width, int strip_height, StripSink* sink);
+    void shutdown(); // Finishes queued flushes, stops the thread and frees the buffers
+
+    // Renders 'area' of the frame (the list already cropped to it, see DrawList::cropTo) top to
+    // bottom. Returns once the last strip is queued; its flush may still be running.
+    void render(DrawList& list, const DrawRect& area);
+    void waitIdle(); // Until every queued strip has been flushed
+
+    bool cacheLayer(const uint16_t* art, int width, int height, int period) { return compositor.cacheLayer(art, width, height, period); }
+    void forgetSource(const uint16_t* pixels) { compositor.forget(pixels); } // See ScanlineCompositor::forget
+    const CompositorStats& compositorStats() const { return compositor.stats(); }
+    const StripStats& stats() const { return last_stats; }
+    int stripHeight() const { return strip_height; }
+    // Strip buffers plus the compositor's heap (caches and scratch), in bytes
+    size_t memoryBytes() const;
+
+private:
+    static const int STRIP_BUFFERS = 2;
+
+    void flushLoop();
+
+    ScanlineCompositor compositor;
+    StripSink* sink;
+    int max_width;
+    int strip_height;
+    std::vector<uint16_t> buffers[STRIP_BUFFERS];
+    int render_next; // Buffer the next strip renders into
+    StripStats last_stats;
+
+    // Shared with the flush thread (guarded by 'mutex')
+    std::mutex mutex;
+    std::condition_variable changed;
+    DrawRect queued_area[STRIP_BUFFERS];
+    bool queued[STRIP_BUFFERS]; // Rendered, waiting for or in the middle of its flush
+    int flush_next;             // Buffer the flush thread takes next (strips flush in order)
+    bool stopping;
+    std::thread flusher;
+};
+
+#endif // STRIP_RENDERER_H
@@ -0,0 +1,59 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <stdint.h>
+
+// Lock-free single-producer/single-consumer hand-off of the newest value. The producer fills
+// back() and publish()es it; the consumer acquire()s and reads front(). The third slot sits in
+// the middle, so neither side ever waits for the other: publishing over a value the consumer
+// hasn't taken replaces it (publish() says so), and acquiring with nothing new keeps the old one.
+//
+// Slots keep their contents when they rotate, so values holding buffers (vectors) stop
+// allocating once every slot has grown to size.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(1), back_index(0), front_index(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // --- Producer ---
+    T& back() { return slots[back_index]; }
+    // Hands back() to the consumer and takes a new back(). Returns false if that replaced an
+    // earlier value the consumer never acquired.
+    bool publish() {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(back_index | FRESH), std::memory_order_acq_rel);
+        back_index = previous & INDEX;
+        return !(previous & FRESH);
+    }
+
+    // --- Consumer ---
+    // Takes the newest published value into front(); false (front() unchanged) if none since last time
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(front_index), std::memory_order_acq_rel);
+        front_index = previous & INDEX;
+        return true;
+    }
+    T& front() { return slots[front_index]; }
+
+    // Either side: a published value is waiting to be acquired
+    bool pending() const { return (middle.load(std::memory_order_acquire) & FRESH) != 0; }
+
+    // Every slot, for setup while neither side is running (e.g. sizing buffers)
+    T& slot(int i) { return slots[i]; }
+    static const int SLOTS = 3;
+
+private:
+    static const uint8_t INDEX = 0x3;
+    static const uint8_t FRESH = 0x4;
+
+    T slots[SLOTS];
+    std::atomic<uint8_t> middle; // Index of the middle slot, FRESH if published and not yet acquired
+    int back_index;              // Producer's
+    int front_index;             // Consumer's
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -0,0 +1,117 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+struct BlitSurface;
+
+// Per-command flags
+enum DrawFlags : uint8_t {
+    DRAW_COLOR_KEY = 1 << 0, // Skip magenta (0xF81F) source pixels
+    DRAW_OPAQUE    = 1 << 1, // Source has no transparent pixels: covers its whole clipped rect
+    DRAW_FLIP_X    = 1 << 2, // Mirror horizontally
+    DRAW_FLIP_Y    = 1 << 3, // Mirror vertically
+};
+
+struct DrawRect {
+    int16_t x, y, w, h;
+};
+
+// One recorded blit: copy a (width x height) window at (source_x, source_y) of an RGB565
+// source buffer to (dest_x, dest_y), restricted to 'clip'.
+struct DrawCommand {
+    const uint16_t* pixels;
+    int16_t source_width, source_height; // Dimensions of the whole source buffer
+    int16_t source_x, source_y;
+    int16_t dest_x, dest_y;
+    int16_t width, height;
+    DrawRect clip;   // Destination-space clip, already intersected with the blit's rect
+    uint8_t layer;   // Lower layers are drawn first
+    uint8_t flags;   // DrawFlags
+    uint16_t sequence; // Submission order, used to keep sorts stable
+};
+
+// A frame's worth of recorded draw commands, handed to IDisplay::submit().
+//
+// Storage is sized once at construction and reused every frame, so recording never
+// allocates; blits past capacity are dropped (and counted) rather than growing the arena.
+// The backend owns the list during submit() and may reorder or drop commands.
+class DrawList {
+public:
+    explicit DrawList(size_t capacity);
+
+    // --- Recording ---
+    void reset();                // Begin a new frame; keeps the storage
+    void clear(uint16_t color);  // Clear the target before the first blit
+    void setClip(int x, int y, int width, int height); // Applies to subsequent blits
+    void resetClip();
+    // Only this part of the target differs from the last submitted frame, so the backend may
+    // redraw (and upload) just that; an empty rect means nothing changed. Default: everything.
+    void setDamage(int x, int y, int width, int height);
+    // Returns false if the command was dropped (arena full); fully clipped blits succeed as no-ops
+    bool blit(uint8_t layer, int dest_x, int dest_y, int width, int height,
+              const uint16_t* pixels, int source_width, int source_height,
+              int source_x, int source_y, uint8_t flags = DRAW_COLOR_KEY);
+
+    // --- Backend passes ---
+    void sortByLayer();     // Stable counting sort by layer (no allocation)
+    size_t cullOccluded();  // Drops commands hidden under a later DRAW_OPAQUE command; returns count
+    // Damage rect within a (width x height) target: the whole target if none was set
+    // Rounded out to whole groups of 'row_step' rows (see ScanlineCompositor::setRowStep), so
+    // rows repeated at reduced resolution are redrawn together with the row they repeat.
+    DrawRect damageWithin(int width, int height, int row_step = 1) const;
+    // Restricts every command to 'rect' and moves its top-left corner to the origin, so the
+    // region can be rendered into a surface of its own. Commands outside it are dropped.
+    void cropTo(const DrawRect& rect);
+    int originY() const { return origin_y; } // Row of the whole target that row 0 is (cropTo() moves it)
+
+    // --- Access ---
+    DrawCommand* commands() { return storage.data(); }
+    const DrawCommand* commands() const { return storage.data(); }
+    size_t size() const { return count; }
+    size_t capacity() const { return storage.size(); }
+    size_t droppedCount() const { return dropped; }
+    bool hasClear() const { return has_clear; }
+    uint16_t clearColor() const { return clear_color; }
+
+private:
+    std::vector<DrawCommand> storage; // Fixed-size arena
+    std::vector<DrawCommand> scratch; // Sort buffer, same size
+    std::vector<uint32_t> opaque_indices; // Cull scratch
+    size_t count;
+    size_t dropped;
+    DrawRect current_clip;
+    bool has_clear;
+    uint16_t clear_color;
+    bool has_damage;
+    DrawRect damage_rect;
+    int origin_y;
+};
+
+// DRAW_FLIP_* flags as BlitFlip flags
+inline uint8_t blitFlip(uint8_t flags) {
+    return ((flags & DRAW_FLIP_X) ? 1 : 0) | ((flags & DRAW_FLIP_Y) ? 2 : 0); // BLIT_FLIP_X | BLIT_FLIP_Y
+}
+
+// Runs one command with the software blitter (clip once, specialised kernel; honours all flags)
+int blitDrawCommand(const BlitSurface& target, const DrawCommand& cmd);
+
+// Plays 'list' back on any display type: layer sort, occlusion cull, clear, then one
+// drawCommand per command. Templated so a concrete (final) backend gets direct, inlinable
+// calls instead of one virtual call per blit.
+template <typename Display>
+void replayDrawList(Display& display, DrawList& list) {
+    list.sortByLayer();
+    list.cullOccluded();
+
+    if (list.hasClear()) display.clear(list.clearColor());
+
+    const DrawCommand* cmd = list.commands();
+    for (size_t i = 0; i < list.size(); ++i, ++cmd) {
+        display.drawCommand(*cmd);
+    }
+}
+
+#endif // DRAW_LIST_H
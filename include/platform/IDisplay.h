@@ -3,6 +3,11 @@
 
 #include <stdint.h> // For uint16_t
 
+class DrawList;
+struct DrawCommand;
+struct CompositorStats;
+struct RenderCounters;
+
 // Interface definition for display operations
 class IDisplay {
 public:
@@ -16,6 +21,34 @@ public:
                             int sourceBufferWidth, int sourceBufferHeight,
                             int sourceX, int sourceY) = 0;
     virtual void present() = 0; // Show the drawn buffer on screen
+
+    // Executes a recorded frame. The backend may reorder, merge or drop commands in 'list', and
+    // may redraw only its damage rect. Default: layer sort, occlusion cull, then one
+    // drawCommand per command (everything is redrawn).
+    virtual void submit(DrawList& list);
+    // Executes one recorded blit. Default: drawPixels on its clip rect (flip flags unsupported).
+    virtual void drawCommand(const DrawCommand& cmd);
+    // Counters from the last submit(), if the backend composites (nullptr otherwise)
+    virtual const CompositorStats* compositorStats() const { return nullptr; }
+    // Traffic counters of the last presented frame, if the backend keeps them (nullptr otherwise)
+    virtual const RenderCounters* renderCounters() const { return nullptr; }
+    // Hint: 'art' is a background drawn every frame whose columns repeat every 'period'; the
+    // backend may keep it resident in its own pixel format. Returns false if the backend already
+    // keeps 'art' at another size or period (the first one stays).
+    virtual bool cacheLayer(const uint16_t* /*art*/, int /*width*/, int /*height*/, int /*period*/) { return true; }
+    // 'pixels' is about to be freed and its address may come back for another image: drop
+    // anything derived from it. Backends that cache per source image must implement this.
+    virtual void forgetSource(const uint16_t* /*pixels*/) {}
+    // Quality hint under load: compose every step-th row only and repeat it (ignored if unsupported)
+    virtual void setCompositionRowStep(int /*step*/) {}
+    // Backends that draw on another thread: a frame finished since the last present(), which
+    // would show it. Such backends wake a sleeping game loop with an event when one does.
+    virtual bool framePending() const { return false; }
+    // How many of the 'submitted' frames have reached the screen. Backends that draw on
+    // another thread lag behind; the rest show every submit() at the next present().
+    virtual uint64_t framesShown(uint64_t submitted) const { return submitted; }
+    // Debug overlay tinting each pixel by how many times it was stored (ignored if unsupported)
+    virtual void setHeatMap(bool /*enabled*/) {}
 };
 
 #endif // IDISPLAY_H
\ No newline at end of file
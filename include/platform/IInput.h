@@ -2,21 +2,35 @@
 #define IINPUT_H
 
 #include <SDL_keycode.h>
+#include <stdint.h>
 
 // Define generic input actions
 enum class InputAction {
     QUIT,
     STEP, // Simulate shaking/pedometer step
-    SELECT_DIGI_1,
-    SELECT_DIGI_2,
-    SELECT_DIGI_3,
-    SELECT_DIGI_4,
-    SELECT_DIGI_5,
-    SELECT_DIGI_6,
-    SELECT_DIGI_7,
-    SELECT_DIGI_8,
+    SELECT_NEXT, // Next Digimon in the roster, wrapping round; the roster can be any size
+    SELECT_PREV,
+    TOGGLE_CROWD, // Switch between the single character and the crowd view
+    TOGGLE_HEATMAP, // Debug: tint pixels by how many times they were stored
+    NEXT_SCENE, // Cycle through the loaded parallax scenes
     UNKNOWN // Placeholder
 };
+const int INPUT_ACTION_COUNT = static_cast<int>(InputAction::UNKNOWN);
+static_assert(INPUT_ACTION_COUNT <= 32, "InputState holds one bit per action");
+
+inline uint32_t actionBit(InputAction action) { return 1u << static_cast<int>(action); }
+
+// Names used by binding files ("quit", "step", "select_next", "select_prev", "crowd", "heatmap",
+// "next_scene")
+const char* inputActionName(InputAction action);
+InputAction inputActionFromName(const char* name); // UNKNOWN if there's no such action
+
+// Every action's state for one frame, one bit each (actionBit)
+struct InputState {
+    uint32_t pressed;  // Went down since the last update()
+    uint32_t held;     // Down now
+    uint32_t released; // Went up since the last update()
+};
 
 // Interface definition for input operations
 class IInput {
@@ -24,10 +38,26 @@ public:
     virtual ~IInput() = default;
 
     virtual void update() = 0; // Poll hardware events
-    virtual bool wasActionPressed(InputAction action) const = 0; // Check press this frame
+    // Sleep until an event arrives or 'timeout_ms' passes; true if woken by one.
+    // Input that arrived is left for the next update().
+    virtual bool waitForInput(uint32_t timeout_ms) = 0;
+    virtual InputState actions() const = 0; // This frame's state of every action
+    bool wasActionPressed(InputAction action) const { return (actions().pressed & actionBit(action)) != 0; }
     virtual bool isQuitRequested() const = 0;
-    // virtual int getShakeCount() = 0; // Add later
+    // When the earliest of this frame's presses arrived (SDL_GetPerformanceCounter), 0 if
+    // none or unknown: the start of input-to-present latency
+    virtual uint64_t pressTimestamp() const { return 0; }
+    // Replaces the key bindings with a binding file's; false (bindings unchanged) if it can't
+    // be used or the input has no keys
+    virtual bool loadBindings(const char* /*path*/) { return false; }
+    // Steps detected since start and the current cadence (steps/min, 0 = not walking), for
+    // inputs with an accelerometer behind them; each step is also a STEP press
+    virtual uint32_t getShakeCount() const { return 0; }
+    virtual uint16_t getCadence() const { return 0; }
+    // STEP presses this frame: the STEP bit holds one, but an accelerometer may have counted
+    // several steps since the last update()
+    virtual uint32_t stepsPressed() const { return wasActionPressed(InputAction::STEP) ? 1 : 0; }
     // virtual bool getTouchPosition(int& x, int& y) = 0; // Add later
 };
 
-#endif // IINPUT_H
\ No newline at end of file
+#endif // IINPUT_H
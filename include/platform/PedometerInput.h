@@ -0,0 +1,49 @@
+#ifndef PEDOMETER_INPUT_H
+#define PEDOMETER_INPUT_H
+
+#include "platform/IInput.h"
+#include "AccelSource.h"
+#include "GameClock.h"
+#include "StepDetector.h"
+#include <memory>
+
+// Real steps instead of the space bar: wraps another input (the keys still do everything
+// else) and runs an accelerometer source through a StepDetector, turning each detected step
+// into a STEP press; stepsPressed() counts them when one update() brings several. Samples
+// are taken as the clock says they're due and processed a batch at a time, as from a sensor
+// FIFO; waitForInput() wakes at least every WAKE_MS for them.
+class PedometerInput final : public IInput {
+public:
+    PedometerInput(IInput* keys, AccelSource* source, GameClock& clock); // Owns 'keys' and 'source'
+
+    // --- IInput Interface Implementation ---
+    void update() override;
+    bool waitForInput(uint32_t timeout_ms) override;
+    InputState actions() const override { return state; }
+    bool isQuitRequested() const override { return keys->isQuitRequested(); }
+    uint64_t pressTimestamp() const override { return keys->pressTimestamp(); }
+    bool loadBindings(const char* path) override { return keys->loadBindings(path); }
+    uint32_t getShakeCount() const override { return detector.steps(); }
+    uint16_t getCadence() const override { return detector.cadence(); }
+    uint32_t stepsPressed() const override { return steps_pressed; }
+
+private:
+    static const size_t BATCH = 64;       // Samples per StepDetector::process()
+    static const size_t MAX_EVENTS = 16;  // Events per batch (a batch is at most ~1.3 s of samples)
+    static const uint32_t WAKE_MS = 100;  // Longest a sample waits to be processed while idle
+
+    std::unique_ptr<IInput> keys;
+    std::unique_ptr<AccelSource> source;
+    GameClock& clock;
+    StepDetector detector;
+    InputState state;
+    uint32_t steps_pressed; // Detected steps (and STEP key presses) since the last update()
+    bool started;
+    bool source_ended;
+    uint32_t start_ms;
+    uint64_t samples_read;
+    AccelSample batch[BATCH];
+    StepEvent events[MAX_EVENTS];
+};
+
+#endif // PEDOMETER_INPUT_H
@@ -0,0 +1,24 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+// Platform types Game talks to.
+//
+// Default build: the abstract interfaces, so any backend can be plugged in at runtime.
+// DIGIVICE_STATIC_PLATFORM: the concrete (final) PC classes and nothing else, for a build
+// that only ever runs in a window. Game's own display/input calls (a handful a frame) bind
+// statically, but the blits don't get cheaper: PCDisplay::submit() composites the frame in
+// both builds, so frame times are the same. Replays, the pedometer and the monochrome LCD
+// need the interfaces; main() refuses their options in this build.
+#ifdef DIGIVICE_STATIC_PLATFORM
+#include "platform/pc/PCDisplay.h"
+#include "platform/pc/PCInput.h"
+typedef PCDisplay PlatformDisplay;
+typedef PCInput PlatformInput;
+#else
+#include "platform/IDisplay.h"
+#include "platform/IInput.h"
+typedef IDisplay PlatformDisplay;
+typedef IInput PlatformInput;
+#endif
+
+#endif // PLATFORM_H
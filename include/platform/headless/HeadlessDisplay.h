@@ -0,0 +1,54 @@
+#ifndef HEADLESS_DISPLAY_H
+#define HEADLESS_DISPLAY_H
+
+#include "platform/IDisplay.h"
+#include "Blitter.h"
+#include "SoftwareRenderer.h"
+#include "platform/DrawList.h" // DrawRect
+#include <vector>
+#include <stdint.h>
+
+// Display backend that renders into an in-memory ARGB8888 framebuffer and never opens a
+// window. Used by benchmarks and headless runs.
+class HeadlessDisplay final : public IDisplay {
+public:
+    HeadlessDisplay();
+    ~HeadlessDisplay() override = default;
+
+    // --- IDisplay Interface Implementation ---
+    bool init(const char* title, int windowWidth, int windowHeight) override;
+    void close() override;
+    void clear(uint16_t color) override;
+    void drawPixels(int destX, int destY, int width, int height,
+                    const uint16_t* pixelData,
+                    int sourceBufferWidth, int sourceBufferHeight,
+                    int sourceX, int sourceY) override;
+    void present() override;
+    void submit(DrawList& list) override; // Scanline compositing: each pixel written once
+    void drawCommand(const DrawCommand& cmd) override;
+    const CompositorStats* compositorStats() const override { return renderer.compositorStats(); }
+    const RenderCounters* renderCounters() const override { return &renderer.counters(); }
+    bool cacheLayer(const uint16_t* art, int width, int height, int period) override {
+        return renderer.cacheLayer(art, width, height, period);
+    }
+    void forgetSource(const uint16_t* pixels) override { renderer.forgetSource(pixels); }
+    void setHeatMap(bool enabled) override { renderer.setHeatMap(enabled); }
+
+    const uint32_t* pixels() const { return framebuffer.data(); }
+    int width() const { return screenWidth; }
+    int height() const { return screenHeight; }
+    uint64_t framesPresented() const { return presentedFrames; }
+    uint32_t frameHash() const; // FNV-1a of the framebuffer: equal frames, equal hashes
+
+private:
+    SoftwareRenderer renderer;
+    BlitSurface surface();
+    BlitSurface surface(const DrawRect& rect); // Part of the framebuffer
+
+    std::vector<uint32_t> framebuffer;
+    int screenWidth;
+    int screenHeight;
+    uint64_t presentedFrames;
+};
+
+#endif // HEADLESS_DISPLAY_H
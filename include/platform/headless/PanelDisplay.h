@@ -0,0 +1,85 @@
+#ifndef PANEL_DISPLAY_H
+#define PANEL_DISPLAY_H
+
+#include "platform/IDisplay.h"
+#include "platform/headless/SpiPanel.h"
+#include "Blitter.h"
+#include "RenderCounters.h"
+#include "StripRenderer.h"
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+// How much of the screen goes over the bus each frame
+enum class FlushStrategy {
+    FULL_FRAME,  // Everything, every frame (no damage tracking)
+    DAMAGE_ROWS, // Full-width band of the damaged rows
+    DAMAGE_RECT, // Just the damage rect (grown to the controller's window alignment)
+};
+const int FLUSH_STRATEGY_COUNT = 3;
+const char* flushStrategyName(FlushStrategy strategy);
+
+// Display backend for tuning the panel link without hardware: frames are strip-rendered
+// (StripRenderer) and sent to an SpiPanel model through one CASET/RASET window per frame,
+// the first strip with RAMWR and the rest with RAMWR_CONT. Runs headless.
+// Immediate-mode calls (clear, drawPixels, drawCommand) draw into a full-size shadow buffer
+// whose touched area present() sends; they are a debug path and don't mix with submit().
+//
+// Only the chosen strategy is rendered and sent, but every submit() also prices the frame
+// under each strategy, so one run reports the bus time and maximum FPS of all of them.
+class PanelDisplay final : public IDisplay, private StripSink {
+public:
+    PanelDisplay(const SpiBusConfig& bus, FlushStrategy strategy, int strip_height = 16);
+    ~PanelDisplay() override;
+
+    // --- IDisplay Interface Implementation ---
+    bool init(const char* title, int windowWidth, int windowHeight) override;
+    void close() override;
+    void clear(uint16_t color) override;
+    void drawPixels(int destX, int destY, int width, int height,
+                    const uint16_t* pixelData,
+                    int sourceBufferWidth, int sourceBufferHeight,
+                    int sourceX, int sourceY) override;
+    void present() override; // Waits for the frame's last flush
+    void submit(DrawList& list) override;
+    void drawCommand(const DrawCommand& cmd) override;
+    const CompositorStats* compositorStats() const override { return &strips.compositorStats(); }
+    const RenderCounters* renderCounters() const override { return &last_frame; }
+    bool cacheLayer(const uint16_t* art, int width, int height, int period) override {
+        return strips.cacheLayer(art, width, height, period);
+    }
+    void forgetSource(const uint16_t* pixels) override { strips.forgetSource(pixels); }
+
+    // --- Bus report (totals since init) ---
+    const SpiPanel* panel() const { return link.get(); }
+    // Bus traffic every submitted frame would have caused under 'strategy'
+    const PanelTraffic& estimate(FlushStrategy strategy) const { return estimates[static_cast<int>(strategy)]; }
+    uint32_t framesSubmitted() const { return frames_submitted; }
+    // Frame rate the bus alone allows under 'strategy' (0 if nothing was sent)
+    double maxFps(FlushStrategy strategy) const;
+
+private:
+    void flushStrip(const DrawRect& area, const uint16_t* pixels) override; // Flush thread
+    DrawRect flushArea(FlushStrategy strategy, const DrawRect& damage) const;
+    BlitSurface shadowSurface();
+    void markImmediate(int x, int y, int w, int h);
+
+    StripRenderer strips;
+    std::unique_ptr<SpiPanel> link;
+    SpiBusConfig bus_config;
+    FlushStrategy flush_strategy;
+    int strip_height;
+    int screenWidth;
+    int screenHeight;
+    DrawRect frame_area; // What this frame sends (all its strips)
+    bool window_open;    // Flush thread: the frame's window is set, so strips continue it
+    std::vector<uint16_t> shadow; // Immediate-mode target, allocated on first use
+    int dirty_x0, dirty_y0, dirty_x1, dirty_y1; // Shadow area drawn since the last present()
+    PanelTraffic estimates[FLUSH_STRATEGY_COUNT];
+    uint32_t frames_submitted;
+    PanelTraffic at_frame_start; // Panel totals when the current frame began
+    RenderCounters frame;
+    RenderCounters last_frame;
+};
+
+#endif // PANEL_DISPLAY_H
@@ -0,0 +1,37 @@
+#ifndef REPLAY_INPUT_H
+#define REPLAY_INPUT_H
+
+#include "platform/IInput.h"
+#include "InputRecording.h"
+#include "GameClock.h"
+
+// Plays a recorded session back (see InputRecording.h). Each update() delivers the recorded
+// frames due by the game clock, merged if several are (step counts added up); once the
+// recording's end is reached quit is requested. waitForInput() sleeps the clock to the next
+// recorded frame, which with a virtual clock is instant: paired with one, a replay makes the
+// same frames on every run, as fast as they can be drawn.
+class ReplayInput final : public IInput {
+public:
+    ReplayInput(const InputRecording& recording, GameClock& clock);
+
+    // --- IInput Interface Implementation ---
+    void update() override;
+    bool waitForInput(uint32_t timeout_ms) override;
+    InputState actions() const override { return state; }
+    uint32_t stepsPressed() const override { return steps; }
+    bool isQuitRequested() const override { return quit_requested; }
+
+private:
+    uint32_t sessionTime() const; // ms since the first update()
+
+    InputRecording recording;
+    GameClock& clock;
+    bool started;
+    uint32_t start_ms;
+    size_t next; // First frame not delivered yet
+    InputState state;
+    uint32_t steps; // Recorded stepsPressed() of the frames delivered by the last update()
+    bool quit_requested;
+};
+
+#endif // REPLAY_INPUT_H
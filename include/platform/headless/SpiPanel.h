@@ -0,0 +1,84 @@
+#ifndef SPI_PANEL_H
+#define SPI_PANEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// MIPI DCS commands the panel model understands
+enum PanelCommand : uint8_t {
+    PANEL_CASET = 0x2A,        // Column address set: x0, x1 (inclusive), 16-bit big-endian each
+    PANEL_RASET = 0x2B,        // Row address set: y0, y1
+    PANEL_RAMWR = 0x2C,        // Memory write from the window's top-left
+    PANEL_RAMWR_CONT = 0x3C,   // Memory write continuing where the last one stopped
+};
+
+// Serial link to the panel. Commands and their parameters go over 'command_lanes' data lines,
+// pixel data over 'data_lanes' (QSPI panels: 1 and 4). Every transaction (one command with its
+// parameters or data) also pays a fixed overhead for chip select and setup.
+struct SpiBusConfig {
+    double clock_hz;
+    int command_lanes;
+    int data_lanes;
+    double transaction_overhead_s;
+    int window_align; // Controllers that need even window edges use 2
+
+    static SpiBusConfig spi(double clock_hz) { return {clock_hz, 1, 1, 1e-6, 1}; }
+    static SpiBusConfig qspi(double clock_hz) { return {clock_hz, 1, 4, 1e-6, 2}; }
+};
+
+// What went over the bus
+struct PanelTraffic {
+    uint64_t bytes;        // Everything: command bytes, parameters and pixel data
+    uint64_t pixel_bytes;  // Pixel data only
+    uint32_t transactions; // Commands sent (each with its parameters or data)
+    uint32_t windows;      // CASET/RASET pairs
+    double bus_seconds;    // Time the transfers occupy the bus
+
+    void add(const PanelTraffic& other) {
+        bytes += other.bytes;
+        pixel_bytes += other.pixel_bytes;
+        transactions += other.transactions;
+        windows += other.windows;
+        bus_seconds += other.bus_seconds;
+    }
+};
+
+// Model of a panel controller on a serial bus: an RGB565 GRAM addressed through a
+// CASET/RASET window that RAMWR fills row by row, plus a bandwidth model that prices every
+// transaction. Pixels arrive in native RGB565 (the byte order on the wire isn't modelled).
+class SpiPanel {
+public:
+    SpiPanel(int width, int height, const SpiBusConfig& bus);
+
+    // CASET + RASET: later memory writes fill [x, x + w) x [y, y + h)
+    void setWindow(int x, int y, int w, int h);
+    // RAMWR (or RAMWR_CONT when 'continuing'): 'count' pixels into the window, wrapping rows
+    void writePixels(const uint16_t* pixels, size_t count, bool continuing);
+
+    // Bus cost of one window update of w x h pixels sent in 'writes' memory writes (the first
+    // RAMWR, the rest RAMWR_CONT), without sending anything. Matches what the calls above count.
+    static PanelTraffic windowCost(const SpiBusConfig& bus, int w, int h, int writes);
+    // A rect grown outward to the bus's window alignment and clamped to the panel
+    void alignWindow(int& x, int& y, int& w, int& h) const;
+
+    const PanelTraffic& traffic() const { return total; }
+    void resetTraffic() { total = {}; }
+    const uint16_t* gram() const { return memory.data(); }
+    int width() const { return panel_width; }
+    int height() const { return panel_height; }
+    const SpiBusConfig& bus() const { return link; }
+
+private:
+    void countCommand(size_t parameter_bytes);
+    static double seconds(const SpiBusConfig& bus, size_t command_bytes, size_t data_bytes);
+
+    int panel_width, panel_height;
+    SpiBusConfig link;
+    std::vector<uint16_t> memory;
+    int window_x0, window_y0, window_x1, window_y1; // Inclusive, as CASET/RASET
+    int cursor_x, cursor_y;
+    PanelTraffic total;
+};
+
+#endif // SPI_PANEL_H
@@ -0,0 +1,62 @@
+#ifndef STRIP_DISPLAY_H
+#define STRIP_DISPLAY_H
+
+#include "platform/IDisplay.h"
+#include "Blitter.h"
+#include "RenderCounters.h"
+#include "StripRenderer.h"
+#include <vector>
+#include <stdint.h>
+
+// Display backend for MCU-class memory budgets: frames are rendered a strip at a time by a
+// StripRenderer and flushed to the panel, so no framebuffer lives in "MCU" memory. The panel's
+// own RAM (GRAM) is modelled as an RGB565 array the flushes land in; read it with panel().
+//
+// The flush thread stands in for DMA. With setBusBytesPerSecond() each flush also takes as long
+// as the bus would need to send the strip, so benchmarks see the render/flush overlap.
+// Immediate-mode calls (clear, drawPixels, drawCommand) write straight into the panel RAM.
+class StripDisplay final : public IDisplay, private StripSink {
+public:
+    explicit StripDisplay(int strip_height = 16);
+    ~StripDisplay() override;
+
+    // --- IDisplay Interface Implementation ---
+    bool init(const char* title, int windowWidth, int windowHeight) override;
+    void close() override;
+    void clear(uint16_t color) override;
+    void drawPixels(int destX, int destY, int width, int height,
+                    const uint16_t* pixelData,
+                    int sourceBufferWidth, int sourceBufferHeight,
+                    int sourceX, int sourceY) override;
+    void present() override; // Waits for the last strip's flush
+    void submit(DrawList& list) override; // Strips of the damage rect, compositor rendered
+    void drawCommand(const DrawCommand& cmd) override;
+    const CompositorStats* compositorStats() const override { return &strips.compositorStats(); }
+    const RenderCounters* renderCounters() const override { return &last_frame; }
+    bool cacheLayer(const uint16_t* art, int width, int height, int period) override {
+        return strips.cacheLayer(art, width, height, period);
+    }
+    void forgetSource(const uint16_t* pixels) override { strips.forgetSource(pixels); }
+
+    void setBusBytesPerSecond(double bytes_per_second) { bus_bytes_per_second = bytes_per_second; } // 0: instant
+    const StripRenderer& renderer() const { return strips; }
+    const uint16_t* panel() const { return gram.data(); }
+    int width() const { return screenWidth; }
+    int height() const { return screenHeight; }
+
+private:
+    void flushStrip(const DrawRect& area, const uint16_t* pixels) override; // Flush thread
+    BlitSurface panelSurface();
+
+    StripRenderer strips;
+    int strip_height;
+    double bus_bytes_per_second;
+    std::vector<uint16_t> gram; // The panel's RAM, not the renderer's
+    int screenWidth;
+    int screenHeight;
+    uint64_t flushed_bytes; // This frame; written by the flush thread
+    RenderCounters frame;
+    RenderCounters last_frame;
+};
+
+#endif // STRIP_DISPLAY_H
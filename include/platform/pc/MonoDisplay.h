@@ -0,0 +1,40 @@
+#ifndef MONO_DISPLAY_H
+#define MONO_DISPLAY_H
+
+#include "platform/IDisplay.h"
+#include "MonoRenderer.h"
+#include <SDL.h>
+#include <stdint.h>
+
+// Monochrome dot-matrix LCD mode: frames are drawn by a MonoRenderer into a 1bpp framebuffer
+// at 1/downscale of the logical screen, then shown scaled up (nearest neighbour) in the SDL
+// window in LCD colours. The window keeps the logical size Game asked for.
+class MonoDisplay final : public IDisplay {
+public:
+    explicit MonoDisplay(int downscale = 4);
+    ~MonoDisplay() override;
+
+    // --- IDisplay Interface Implementation ---
+    bool init(const char* title, int windowWidth, int windowHeight) override;
+    void close() override;
+    void clear(uint16_t color) override;
+    void drawPixels(int destX, int destY, int width, int height,
+                    const uint16_t* pixelData,
+                    int sourceBufferWidth, int sourceBufferHeight,
+                    int sourceX, int sourceY) override;
+    void present() override;
+    void submit(DrawList& list) override; // Redraws everything; damage rects are ignored
+    void drawCommand(const DrawCommand& cmd) override;
+    void forgetSource(const uint16_t* pixels) override { mono.forgetSource(pixels); }
+
+private:
+    static const uint32_t LCD_PAPER = 0xFF9EAD86; // ARGB8888 of an unlit dot
+    static const uint32_t LCD_INK = 0xFF232B1E;   // ... and a dark one
+
+    MonoRenderer mono;
+    SDL_Window* window;
+    SDL_Renderer* renderer;
+    SDL_Texture* texture; // LCD resolution, stretched over the window
+};
+
+#endif // MONO_DISPLAY_H
@@ -2,13 +2,20 @@
 #define PC_DISPLAY_H
 
 #include "platform/IDisplay.h" // <<< Include the interface
+#include "Blitter.h"
+#include "SoftwareRenderer.h"
+#include "RenderThread.h"
 #include <SDL.h>
 #include <vector>
 #include <stdint.h> // Ensure uint types are included
 
-class PCDisplay : public IDisplay { // <<< Inherit from IDisplay
+// 'render_thread': submit() hands frames to a RenderThread that composites them in the
+// background; present() (still on the calling thread, as SDL requires) uploads the newest
+// finished one. Frames then show up one present() later than they were submitted, so a frame
+// finishing while the game loop sleeps wakes it with an SDL user event (see framePending()).
+class PCDisplay final : public IDisplay, private FrameSink { // <<< Inherit from IDisplay
 public:
-    PCDisplay();
+    explicit PCDisplay(bool render_thread = false);
     ~PCDisplay() override; // <<< Use override
 
     // --- IDisplay Interface Implementation ---
@@ -20,16 +27,47 @@ public:
                     int sourceBufferWidth, int sourceBufferHeight,
                     int sourceX, int sourceY) override;
     void present() override;
+    void submit(DrawList& list) override; // Scanline compositing: each pixel written once
+    void drawCommand(const DrawCommand& cmd) override;
+    const CompositorStats* compositorStats() const override;
+    const RenderCounters* renderCounters() const override;
+    bool cacheLayer(const uint16_t* art, int width, int height, int period) override;
+    void forgetSource(const uint16_t* pixels) override;
+    void setCompositionRowStep(int step) override;
+    void setHeatMap(bool enabled) override { software.setHeatMap(enabled); }
+    bool framePending() const override { return threaded && render_thread.framePending(); }
+    uint64_t framesShown(uint64_t submitted) const override { return threaded ? shown_sequence : submitted; }
 
 private:
+    SoftwareRenderer software;
     SDL_Window* window;
     SDL_Renderer* renderer;
     SDL_Texture* texture;
     int screenWidth;
     int screenHeight;
     // std::vector<uint32_t> pixelBuffer; // We write directly to texture now
+    void* lockedPixels; // Non-null while the texture is locked for this frame's draws
+    int lockedPitch;
+    SDL_Rect lockedRect;     // Part of the texture that is locked (and uploaded on unlock)
+    uint64_t uploadedBytes;  // Since the last present()
 
-    uint32_t convertRGB565toARGB8888(uint16_t color); // Keep helper
+    // --- Render thread mode ---
+    bool threaded;
+    RenderThread render_thread; // Started by the first submit(), after the layers are cached
+    Uint32 frame_event;         // SDL user event pushed when a frame finishes
+    int row_step;
+    RenderCounters shown_counters; // Of the frame on screen
+    CompositorStats shown_stats;
+    bool shown_composited;
+    uint64_t shown_sequence; // RenderThread submit number of the frame on screen
+
+    void frameReady() override; // FrameSink, on the render thread
+
+    bool lockTexture(const SDL_Rect& rect);
+    bool lockTexture() { return lockTexture({0, 0, screenWidth, screenHeight}); }
+    void unlockTexture();
+    BlitSurface lockedSurface(const SDL_Rect& rect) const; // 'rect' within lockedRect; valid while locked
+    BlitSurface lockedSurface() const { return lockedSurface(lockedRect); }
 };
 
 #endif // PC_DISPLAY_H
\ No newline at end of file
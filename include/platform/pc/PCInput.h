@@ -2,24 +2,58 @@
 #define PC_INPUT_H
 
 #include "platform/IInput.h" // <<< Include the interface
+#include "SpscQueue.h"
 #include <SDL.h>
-#include <unordered_map>
-#include <unordered_set>
+#include <atomic>
 
-class PCInput : public IInput { // <<< Inherit from IInput
+// Keyboard input through an SDL event watch: key events are timestamped with the performance
+// counter when the main thread pumps them out of the OS (in update() or while the loop waits
+// for input), not when the game gets round to handling them, and passed to update() through
+// a lock-free queue, in order and without allocating. Time a key spent waiting for the pump
+// while a busy frame finished is not seen.
+//
+// Keys are bound by scancode (physical position) in a flat table, one action per key;
+// update() folds the frame's events into InputState bitmasks. Bindings come from a text
+// file, one directive per line, '#' starting a comment:
+//
+//   bind <key> <action>     <key> is an SDL scancode name (A, 1, Space, Escape, F1...),
+//                           <action> an inputActionName(); several keys may share an action
+class PCInput final : public IInput { // <<< Inherit from IInput
 public:
     PCInput();
-    ~PCInput() override = default;
+    ~PCInput() override;
 
     // --- IInput Interface Implementation ---
     void update() override;
-    bool wasActionPressed(InputAction action) const override;
+    bool waitForInput(uint32_t timeout_ms) override;
+    InputState actions() const override { return state; }
     bool isQuitRequested() const override;
+    uint64_t pressTimestamp() const override { return press_timestamp; }
+    bool loadBindings(const char* path) override; // Problems are logged as "file:line: reason"
+
+    void bind(SDL_Scancode key, InputAction action); // UNKNOWN unbinds
+    void clearBindings();
 
 private:
-    std::unordered_map<SDL_Keycode, InputAction> keyActionMap;
-    std::unordered_set<InputAction> pressedActions; // Actions pressed this frame
+    enum KeyEventType : uint8_t { KEY_DOWN, KEY_UP, WINDOW_QUIT };
+    struct KeyEvent {
+        uint16_t scancode;
+        KeyEventType type;
+        uint64_t timestamp; // SDL_GetPerformanceCounter() on arrival
+    };
+    static const size_t EVENT_QUEUE_SIZE = 256; // Key events between two update()s
+
+    static int eventWatch(void* userdata, SDL_Event* event); // Runs on the thread that queues the event
+    void handleKey(const KeyEvent& e);
+
+    uint8_t key_actions[SDL_NUM_SCANCODES]; // InputAction per scancode (UNKNOWN = unbound)
+    uint8_t keys_down[INPUT_ACTION_COUNT];  // Bound keys holding each action down
+    bool key_down[SDL_NUM_SCANCODES];       // Down as far as update() has seen
+    InputState state;
     bool quitRequested;
+    uint64_t press_timestamp; // Earliest arrival among this frame's presses (0 = none)
+    SpscQueue<KeyEvent, EVENT_QUEUE_SIZE> events;
+    std::atomic<uint32_t> events_dropped; // Queue full
 };
 
-#endif // PC_INPUT_H
\ No newline at end of file
+#endif // PC_INPUT_H
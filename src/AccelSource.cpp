@@ -0,0 +1,93 @@
+#include "AccelSource.h"
+#include <math.h>
+#include <stdlib.h>
+
+static int16_t toMilliG(double g) {
+    double mg = g * 1000.0;
+    if (mg > 32767.0) mg = 32767.0;
+    if (mg < -32768.0) mg = -32768.0;
+    return static_cast<int16_t>(lround(mg));
+}
+
+// --- CSV Recordings ---
+CsvAccelSource::CsvAccelSource(int rate_hz) : file(nullptr), rate(rate_hz > 0 ? rate_hz : 100) {}
+
+CsvAccelSource::~CsvAccelSource() {
+    if (file) fclose(file);
+}
+
+bool CsvAccelSource::open(const char* path) {
+    if (file) fclose(file);
+    file = fopen(path, "r");
+    return file != nullptr;
+}
+
+size_t CsvAccelSource::read(AccelSample* out, size_t max) {
+    size_t count = 0;
+    char line[256];
+    while (file && count < max && fgets(line, sizeof(line), file)) {
+        double values[4];
+        int fields = 0;
+        char* cursor = line;
+        while (fields < 4) {
+            char* end;
+            double v = strtod(cursor, &end);
+            if (end == cursor) break;
+            values[fields++] = v;
+            cursor = end;
+            while (*cursor == ' ' || *cursor == '\t') cursor++;
+            if (*cursor != ',') break;
+            cursor++;
+        }
+        if (fields < 3) continue; // Header, comment or blank
+        const double* xyz = values + (fields - 3);
+        out[count++] = {toMilliG(xyz[0]), toMilliG(xyz[1]), toMilliG(xyz[2])};
+    }
+    return count;
+}
+
+// --- Generated Walking ---
+SyntheticAccelSource::SyntheticAccelSource(int rate_hz, int cadence, uint32_t seed, uint32_t duration_s) :
+    rate(rate_hz > 0 ? rate_hz : 100),
+    cadence_spm(cadence > 0 ? cadence : 110),
+    noise(seed),
+    sample(0),
+    end(static_cast<uint64_t>(duration_s) * rate),
+    phase(0.0),
+    cycles(0),
+    steps(0)
+{
+}
+
+size_t SyntheticAccelSource::read(AccelSample* out, size_t max) {
+    const double kTwoPi = 6.28318530717958647692;
+    size_t count = 0;
+    for (; count < max && (end == 0 || sample < end); ++count, ++sample) {
+        const double t = static_cast<double>(sample) / rate;
+        const bool walking = fmod(t, WALK_S + STAND_S) < WALK_S;
+        double bounce = 0.0, sway = 0.0;
+        if (walking) {
+            const double spm = cadence_spm * (1.0 + 0.05 * sin(kTwoPi * t / 60.0)); // Drifts over a minute
+            const double before = phase;
+            phase += spm / 60.0 / rate;
+            if (before < 0.25 && phase >= 0.25) steps++; // The bounce peaks a quarter of the way in
+            if (phase >= 1.0) {
+                phase -= 1.0;
+                cycles++;
+            }
+            bounce = 0.25 * sin(kTwoPi * phase) + 0.08 * sin(2.0 * kTwoPi * phase + 0.6);
+            sway = 0.06 * sin(kTwoPi * (cycles + phase) / 2.0); // Left foot, right foot
+        } else {
+            phase = 0.0; // Each walk starts on a fresh step
+        }
+        double n[3];
+        for (double& axis : n) {
+            noise = noise * 1664525u + 1013904223u;
+            axis = ((noise >> 8) / 16777216.0 - 0.5) * 0.06; // +-30 mg
+        }
+        // Gravity (and the bounce along it) 30 degrees off the z axis
+        const double vertical = 1.0 + bounce;
+        out[count] = {toMilliG(sway + n[0]), toMilliG(0.5 * vertical + n[1]), toMilliG(0.866 * vertical + n[2])};
+    }
+    return count;
+}
@@ -0,0 +1,236 @@
+#include "AssetManager.h"
+
+#include <SDL_log.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+AssetManager::AssetManager(const std::vector<AssetSource>& sources, size_t budget_bytes) :
+    sources(sources),
+    budget_bytes(budget_bytes),
+    resident_bytes(0),
+    entries(sources.size()),
+    stopping(false)
+{
+    worker = std::thread(&AssetManager::workerLoop, this);
+}
+
+AssetManager::~AssetManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    work_ready.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+// --- Public API ---
+const CharacterAssets* AssetManager::pinAndLoad(int id) {
+    if (id < 0 || id >= count()) return nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    Entry& entry = entries[id];
+    entry.pins++;
+    if (entry.assets) {
+        touch(id);
+        return entry.assets.get();
+    }
+
+    // Miss: decode here rather than wait behind the worker's queue
+    lock.unlock();
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AssetManager: blocking load of character %d", id);
+    std::unique_ptr<CharacterAssets> assets = decode(id);
+    lock.lock();
+
+    if (!entry.assets) { // The worker may have beaten us to it
+        install(id, std::move(assets), false);
+    } else {
+        touch(id);
+    }
+    return entry.assets.get();
+}
+
+void AssetManager::pinAsync(int id) {
+    if (id < 0 || id >= count()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& entry = entries[id];
+        entry.pins++;
+        if (entry.assets) {
+            touch(id);
+            return;
+        }
+        // Jump the queue, upgrading an existing speculative job if there is one
+        jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [id](const Job& job) { return job.id == id; }), jobs.end());
+        jobs.push_front({id, false});
+        entry.queued = true;
+    }
+    work_ready.notify_one();
+}
+
+void AssetManager::prefetch(int id) {
+    if (id < 0 || id >= count()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& entry = entries[id];
+        if (entry.assets) {
+            touch(id); // Predicted to be used soon, keep it warm
+            return;
+        }
+        if (entry.queued) return;
+        jobs.push_back({id, true});
+        entry.queued = true;
+    }
+    work_ready.notify_one();
+}
+
+const CharacterAssets* AssetManager::find(int id) {
+    if (id < 0 || id >= count()) return nullptr;
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = entries[id];
+    if (!entry.assets) return nullptr;
+    touch(id);
+    return entry.assets.get();
+}
+
+void AssetManager::unpin(int id) {
+    if (id < 0 || id >= count()) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries[id].pins > 0) {
+        entries[id].pins--;
+    }
+    // Stays resident (and evictable) until something needs the room
+}
+
+bool AssetManager::isResident(int id) const {
+    if (id < 0 || id >= count()) return false;
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries[id].assets != nullptr;
+}
+
+size_t AssetManager::residentBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return resident_bytes;
+}
+
+void AssetManager::takeEvicted(std::vector<const uint16_t*>& evicted) {
+    evicted.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    evicted.swap(evicted_frames);
+}
+
+// --- Helpers ---
+std::unique_ptr<CharacterAssets> AssetManager::decode(int id) const {
+    const AssetSource& source = sources[id];
+    std::unique_ptr<CharacterAssets> assets(new CharacterAssets());
+
+    size_t total_pixels = 0;
+    for (int i = 0; i < source.frame_count; ++i) {
+        total_pixels += static_cast<size_t>(source.frames[i].width) * source.frames[i].height;
+    }
+    assets->pixels.resize(total_pixels);
+    assets->frames.resize(source.frame_count);
+
+    // RGB565 sources are copied as-is; this is where a compressed or external format would be unpacked
+    size_t offset = 0;
+    for (int i = 0; i < source.frame_count; ++i) {
+        const SpriteFrame& src = source.frames[i];
+        size_t frame_pixels = static_cast<size_t>(src.width) * src.height;
+        if (src.data) {
+            std::memcpy(&assets->pixels[offset], src.data, frame_pixels * sizeof(uint16_t));
+        }
+        assets->frames[i].width = src.width;
+        assets->frames[i].height = src.height;
+        assets->frames[i].data = src.data ? &assets->pixels[offset] : nullptr;
+        offset += frame_pixels;
+    }
+    assets->bytes = total_pixels * sizeof(uint16_t);
+    return assets;
+}
+
+bool AssetManager::install(int id, std::unique_ptr<CharacterAssets> assets, bool speculative) {
+    Entry& entry = entries[id];
+    size_t bytes = assets->bytes;
+
+    if (speculative && entry.pins == 0 && !canFit(bytes, id)) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "AssetManager: dropped prefetch of character %d (no room)", id);
+        return false;
+    }
+    if (!makeRoom(bytes, id)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AssetManager: pinned characters exceed budget (%zu + %zu > %zu bytes)",
+                    resident_bytes, bytes, budget_bytes);
+    }
+
+    entry.assets = std::move(assets);
+    lru.push_front(id);
+    entry.lru_pos = lru.begin();
+    resident_bytes += bytes;
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "AssetManager: character %d resident (%zu/%zu bytes)", id, resident_bytes, budget_bytes);
+    return true;
+}
+
+bool AssetManager::canFit(size_t bytes_needed, int keep_id) const {
+    size_t evictable = 0;
+    for (int resident_id : lru) {
+        if (resident_id != keep_id && entries[resident_id].pins == 0) {
+            evictable += entries[resident_id].assets->bytes;
+        }
+    }
+    return resident_bytes - evictable + bytes_needed <= budget_bytes;
+}
+
+bool AssetManager::makeRoom(size_t bytes_needed, int keep_id) {
+    while (resident_bytes + bytes_needed > budget_bytes) {
+        // Least recently used unpinned character goes first
+        auto victim = lru.end();
+        for (auto it = lru.rbegin(); it != lru.rend(); ++it) {
+            if (*it != keep_id && entries[*it].pins == 0) {
+                victim = std::next(it).base();
+                break;
+            }
+        }
+        if (victim == lru.end()) return false;
+
+        int victim_id = *victim;
+        Entry& entry = entries[victim_id];
+        resident_bytes -= entry.assets->bytes;
+        for (const SpriteFrame& frame : entry.assets->frames) {
+            if (frame.data) evicted_frames.push_back(frame.data);
+        }
+        entry.assets.reset();
+        lru.erase(victim);
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "AssetManager: evicted character %d", victim_id);
+    }
+    return true;
+}
+
+void AssetManager::touch(int id) {
+    lru.splice(lru.begin(), lru, entries[id].lru_pos);
+}
+
+void AssetManager::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        work_ready.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (stopping) return;
+
+        Job job = jobs.front();
+        jobs.pop_front();
+        Entry& entry = entries[job.id];
+        entry.queued = false;
+        if (entry.assets) continue;
+
+        lock.unlock();
+        std::unique_ptr<CharacterAssets> assets = decode(job.id);
+        lock.lock();
+
+        if (stopping) return;
+        if (!entry.assets) {
+            // A job queued as a prefetch may have been pinned in the meantime
+            install(job.id, std::move(assets), job.speculative && entry.pins == 0);
+        }
+    }
+}
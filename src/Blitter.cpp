@@ -0,0 +1,209 @@
+#include "Blitter.h"
+
+namespace {
+
+// --- Pixel format traits ---
+template <PixelFormat F> struct Pixel;
+
+template <> struct Pixel<PixelFormat::RGB565> {
+    typedef uint16_t type;
+    static bool isKey(type p) { return p == COLOR_KEY_RGB565; }
+    static uint32_t alpha(type) { return 255; }
+    static uint32_t toArgb(type p) { return rgb565ToArgb8888(p); }
+    static type fromArgb(uint32_t c) { return argb8888ToRgb565(c); }
+};
+
+template <> struct Pixel<PixelFormat::ARGB8888> {
+    typedef uint32_t type;
+    static bool isKey(type p) { return p == COLOR_KEY_ARGB8888; }
+    static uint32_t alpha(type p) { return p >> 24; }
+    static uint32_t toArgb(type p) { return p; }
+    static type fromArgb(uint32_t c) { return c; }
+};
+
+// Converts without the ARGB round trip when the formats already match
+template <PixelFormat Src, PixelFormat Dst>
+inline typename Pixel<Dst>::type convertPixel(typename Pixel<Src>::type p) {
+    return Pixel<Dst>::fromArgb(Pixel<Src>::toArgb(p));
+}
+template <> inline uint16_t convertPixel<PixelFormat::RGB565, PixelFormat::RGB565>(uint16_t p) { return p; }
+template <> inline uint32_t convertPixel<PixelFormat::ARGB8888, PixelFormat::ARGB8888>(uint32_t p) { return p; }
+
+// Blends two ARGB8888 colours' RGB by a (0-256); result is opaque
+inline uint32_t blendArgb(uint32_t src, uint32_t dst, uint32_t a) {
+    uint32_t rb = (((src & 0xFF00FF) * a) + ((dst & 0xFF00FF) * (256 - a))) >> 8;
+    uint32_t g = (((src & 0x00FF00) * a) + ((dst & 0x00FF00) * (256 - a))) >> 8;
+    return 0xFF000000u | (rb & 0xFF00FF) | (g & 0x00FF00);
+}
+
+// Everything a kernel needs, already clipped: no bounds checks past this point
+struct BlitSpan {
+    const void* src_row0; // First source pixel to read (accounts for flip)
+    int src_row_step;     // Pixels from one source row to the next (negative when flipped in y)
+    void* dst_row0;
+    int dst_stride;
+    int width, height;
+    uint32_t alpha;       // 1-256
+};
+
+template <PixelFormat Src, PixelFormat Dst, BlitMode Mode, bool FlipX>
+void blitKernel(const BlitSpan& span) {
+    typedef typename Pixel<Src>::type SrcT;
+    typedef typename Pixel<Dst>::type DstT;
+    const int dx = FlipX ? -1 : 1;
+    const int width = span.width; // Locals: stores through dst_row can't alias them
+    const int height = span.height;
+    const int src_step = span.src_row_step;
+    const int dst_stride = span.dst_stride;
+    const uint32_t global_alpha = span.alpha;
+
+    const SrcT* src_row = static_cast<const SrcT*>(span.src_row0);
+    DstT* dst_row = static_cast<DstT*>(span.dst_row0);
+    for (int y = 0; y < height; ++y) {
+        const SrcT* s = src_row;
+        for (int x = 0; x < width; ++x, s += dx) {
+            SrcT p = *s;
+            if (Mode == BLIT_COPY) {
+                dst_row[x] = convertPixel<Src, Dst>(p);
+            } else if (Mode == BLIT_KEY) {
+                // Mask select rather than a branch, so the loop vectorises
+                DstT keep = static_cast<DstT>(0) - static_cast<DstT>(Pixel<Src>::isKey(p));
+                dst_row[x] = static_cast<DstT>((dst_row[x] & keep) | (convertPixel<Src, Dst>(p) & ~keep));
+            } else {
+                uint32_t a = Pixel<Src>::isKey(p) ? 0 : ((Pixel<Src>::alpha(p) + (Pixel<Src>::alpha(p) >> 7)) * global_alpha) >> 8;
+                uint32_t out = blendArgb(Pixel<Src>::toArgb(p), Pixel<Dst>::toArgb(dst_row[x]), a);
+                dst_row[x] = Pixel<Dst>::fromArgb(out);
+            }
+        }
+        src_row += src_step;
+        dst_row += dst_stride;
+    }
+}
+
+typedef void (*BlitKernel)(const BlitSpan&);
+
+// [source format][target format][mode][flip x]. Flip y only changes the row step.
+#define BLIT_MODES(S, D) \
+    { {&blitKernel<S, D, BLIT_COPY, false>,  &blitKernel<S, D, BLIT_COPY, true>}, \
+      {&blitKernel<S, D, BLIT_KEY, false>,   &blitKernel<S, D, BLIT_KEY, true>}, \
+      {&blitKernel<S, D, BLIT_ALPHA, false>, &blitKernel<S, D, BLIT_ALPHA, true>} }
+
+const BlitKernel kKernels[2][2][BLIT_MODE_COUNT][2] = {
+    { BLIT_MODES(PixelFormat::RGB565, PixelFormat::RGB565),   BLIT_MODES(PixelFormat::RGB565, PixelFormat::ARGB8888) },
+    { BLIT_MODES(PixelFormat::ARGB8888, PixelFormat::RGB565), BLIT_MODES(PixelFormat::ARGB8888, PixelFormat::ARGB8888) },
+};
+
+#undef BLIT_MODES
+
+inline int maxInt(int a, int b) { return a > b ? a : b; }
+inline int minInt(int a, int b) { return a < b ? a : b; }
+
+// Visible destination interval along one axis: the blit's own span, the clip, and wherever
+// the (possibly mirrored) source mapping stays inside the source buffer
+inline void clipAxis(int dest, int size, int clip_lo, int clip_hi, int source, int source_size, bool flip,
+                     int& lo, int& hi) {
+    int src_lo = flip ? dest + source + size - source_size : dest - source;
+    int src_hi = flip ? dest + source + size : dest - source + source_size;
+    lo = maxInt(maxInt(dest, clip_lo), src_lo);
+    hi = minInt(minInt(dest + size, clip_hi), src_hi);
+}
+
+} // namespace
+
+bool clipBlit(int target_width, int target_height, const BlitRect* clip,
+              int source_width, int source_height, int source_x, int source_y,
+              const BlitRect& dest, uint8_t flip, BlitClip& out)
+{
+    const bool flip_x = (flip & BLIT_FLIP_X) != 0;
+    const bool flip_y = (flip & BLIT_FLIP_Y) != 0;
+
+    int clip_x0 = 0, clip_y0 = 0, clip_x1 = target_width, clip_y1 = target_height;
+    if (clip) {
+        clip_x0 = maxInt(clip_x0, clip->x);
+        clip_y0 = maxInt(clip_y0, clip->y);
+        clip_x1 = minInt(clip_x1, clip->x + clip->w);
+        clip_y1 = minInt(clip_y1, clip->y + clip->h);
+    }
+
+    int x0, x1, y0, y1;
+    clipAxis(dest.x, dest.w, clip_x0, clip_x1, source_x, source_width, flip_x, x0, x1);
+    clipAxis(dest.y, dest.h, clip_y0, clip_y1, source_y, source_height, flip_y, y0, y1);
+    if (x1 <= x0 || y1 <= y0) return false;
+
+    out.dest = {x0, y0, x1 - x0, y1 - y0};
+    out.source_x = flip_x ? source_x + dest.w - 1 - (x0 - dest.x) : source_x + (x0 - dest.x);
+    out.source_y = flip_y ? source_y + dest.h - 1 - (y0 - dest.y) : source_y + (y0 - dest.y);
+    return true;
+}
+
+int blit(const BlitSurface& target, const BlitRect* clip,
+         const BlitSource& source, int source_x, int source_y, const BlitRect& dest,
+         BlitMode mode, uint8_t flip, uint8_t alpha)
+{
+    if (!target.pixels || !source.pixels || mode >= BLIT_MODE_COUNT) return 0;
+
+    BlitClip visible;
+    if (!clipBlit(target.width, target.height, clip, source.width, source.height,
+                  source_x, source_y, dest, flip, visible)) {
+        return 0;
+    }
+    const int sx = visible.source_x, sy = visible.source_y;
+    const int x0 = visible.dest.x, y0 = visible.dest.y;
+    const bool flip_x = (flip & BLIT_FLIP_X) != 0;
+    const bool flip_y = (flip & BLIT_FLIP_Y) != 0;
+
+    BlitSpan span;
+    span.src_row0 = static_cast<const uint8_t*>(source.pixels) +
+                    (static_cast<long>(sy) * source.stride + sx) * bytesPerPixel(source.format);
+    span.src_row_step = flip_y ? -source.stride : source.stride;
+    span.dst_row0 = static_cast<uint8_t*>(target.pixels) +
+                    (static_cast<long>(y0) * target.stride + x0) * bytesPerPixel(target.format);
+    span.dst_stride = target.stride;
+    span.width = visible.dest.w;
+    span.height = visible.dest.h;
+    span.alpha = static_cast<uint32_t>(alpha) + (alpha >> 7); // 0-255 -> 0-256
+
+    kKernels[static_cast<int>(source.format)][static_cast<int>(target.format)][mode][flip_x ? 1 : 0](span);
+    return span.width * span.height;
+}
+
+void blitRun(const BlitSurface& target, int x, int y, int count,
+             const void* source, PixelFormat source_format, bool flip_x)
+{
+    BlitSpan span;
+    span.src_row0 = source;
+    span.src_row_step = 0;
+    span.dst_row0 = static_cast<uint8_t*>(target.pixels) +
+                    (static_cast<long>(y) * target.stride + x) * bytesPerPixel(target.format);
+    span.dst_stride = 0;
+    span.width = count;
+    span.height = 1;
+    span.alpha = 256;
+    kKernels[static_cast<int>(source_format)][static_cast<int>(target.format)][BLIT_COPY][flip_x ? 1 : 0](span);
+}
+
+bool isOpaque(const uint16_t* pixels, long count) {
+    long keys = 0;
+    for (long i = 0; i < count; ++i) keys += pixels[i] == COLOR_KEY_RGB565; // No early exit: vectorises
+    return keys == 0;
+}
+
+void fillRect(const BlitSurface& target, const BlitRect& rect, uint16_t color) {
+    if (!target.pixels) return;
+    int x0 = maxInt(rect.x, 0), y0 = maxInt(rect.y, 0);
+    int x1 = minInt(rect.x + rect.w, target.width), y1 = minInt(rect.y + rect.h, target.height);
+    if (x1 <= x0 || y1 <= y0) return;
+
+    if (target.format == PixelFormat::RGB565) {
+        uint16_t* row = static_cast<uint16_t*>(target.pixels) + static_cast<long>(y0) * target.stride;
+        for (int y = y0; y < y1; ++y, row += target.stride) {
+            for (int x = x0; x < x1; ++x) row[x] = color;
+        }
+    } else {
+        uint32_t value = rgb565ToArgb8888(color);
+        uint32_t* row = static_cast<uint32_t*>(target.pixels) + static_cast<long>(y0) * target.stride;
+        for (int y = y0; y < y1; ++y, row += target.stride) {
+            for (int x = x0; x < x1; ++x) row[x] = value;
+        }
+    }
+}
@@ -0,0 +1,147 @@
+#include "CrowdRenderer.h"
+#include "EntityStore.h"
+#include "platform/DrawList.h"
+
+CrowdRenderer::CrowdRenderer() :
+    viewport_width(0),
+    viewport_height(0),
+    camera_x(0),
+    culled_count(0),
+    frame_switches(0),
+    sorted_frame_switches(0)
+{
+}
+
+void CrowdRenderer::setViewport(int width, int height) {
+    viewport_width = width;
+    viewport_height = height;
+}
+
+void CrowdRenderer::prepare(const EntityStore& store, const SpriteFrame* const sprites_by_digimon[DIGI_COUNT]) {
+    const size_t count = store.size();
+    keys.clear();
+    order.clear();
+    unsorted.clear();
+    culled_count = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const SpriteFrame* sprites = sprites_by_digimon[store.digimon[i]];
+        if (!sprites) { culled_count++; continue; }
+
+        uint8_t sprite = kAnimFrameRefs[store.frame_ref[i]].sprite;
+        const SpriteFrame& frame = sprites[sprite];
+        int feet_y = static_cast<int>(store.pos_y[i]);
+        int x = static_cast<int>(store.pos_x[i]) - camera_x - frame.width / 2;
+        int y = feet_y - frame.height;
+
+        // Cull anything entirely off screen
+        if (!frame.data || x >= viewport_width || y >= viewport_height || x + frame.width <= 0 || y + frame.height <= 0) {
+            culled_count++;
+            continue;
+        }
+
+        // Depth by the feet row; clamp into 16 bits (visible sprites' feet are within [0, height + sprite))
+        uint32_t depth = feet_y < 0 ? 0u : (feet_y > 0xFFFF ? 0xFFFFu : static_cast<uint32_t>(feet_y));
+        uint32_t source_id = (static_cast<uint32_t>(store.digimon[i]) << 8) | sprite; // Unique per source image
+        keys.push_back((depth << 16) | source_id);
+        order.push_back(static_cast<uint32_t>(unsorted.size()));
+        unsorted.push_back({static_cast<int16_t>(x), static_cast<int16_t>(y), &frame});
+    }
+
+    radixSort();
+
+    draw_list.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i) draw_list[i] = unsorted[order[i]];
+    sorted_frame_switches = countFrameSwitches();
+    batchByFrame();
+    frame_switches = countFrameSwitches();
+}
+
+int CrowdRenderer::countFrameSwitches() const {
+    int switches = 0;
+    const SpriteFrame* previous = nullptr;
+    for (const SpriteDraw& draw : draw_list) {
+        if (draw.frame != previous) switches++;
+        previous = draw.frame;
+    }
+    return switches;
+}
+
+// Each draw joins the newest batch of its frame unless a batch after that one overlaps it
+// (drawing it earlier would then put it behind something it was in front of); batch bounds
+// stand in for their sprites, which only ever refuses a safe move.
+void CrowdRenderer::batchByFrame() {
+    const size_t count = draw_list.size();
+    batches.clear();
+    next_in_batch.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const SpriteDraw& draw = draw_list[i];
+        const int x0 = draw.x, y0 = draw.y;
+        const int x1 = x0 + draw.frame->width, y1 = y0 + draw.frame->height;
+        next_in_batch[i] = UINT32_MAX;
+
+        Batch* join = nullptr;
+        const size_t oldest = batches.size() > BATCH_LOOKBACK ? batches.size() - BATCH_LOOKBACK : 0;
+        for (size_t b = batches.size(); b-- > oldest;) {
+            Batch& batch = batches[b];
+            if (batch.frame == draw.frame) {
+                join = &batch;
+                break;
+            }
+            if (x0 < batch.x1 && batch.x0 < x1 && y0 < batch.y1 && batch.y0 < y1) break;
+        }
+        if (join) {
+            next_in_batch[join->last] = static_cast<uint32_t>(i);
+            join->last = static_cast<uint32_t>(i);
+            join->x0 = join->x0 < x0 ? join->x0 : x0;
+            join->y0 = join->y0 < y0 ? join->y0 : y0;
+            join->x1 = join->x1 > x1 ? join->x1 : x1;
+            join->y1 = join->y1 > y1 ? join->y1 : y1;
+        } else {
+            batches.push_back({draw.frame, x0, y0, x1, y1, static_cast<uint32_t>(i), static_cast<uint32_t>(i)});
+        }
+    }
+
+    batched.clear();
+    for (const Batch& batch : batches) {
+        for (uint32_t i = batch.first; i != UINT32_MAX; i = next_in_batch[i]) batched.push_back(draw_list[i]);
+    }
+    draw_list.swap(batched);
+}
+
+// LSD radix sort of (keys, order), 8 bits per pass; passes where every key shares the digit are skipped
+void CrowdRenderer::radixSort() {
+    const size_t count = keys.size();
+    keys_tmp.resize(count);
+    order_tmp.resize(count);
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t histogram[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            histogram[(keys[i] >> shift) & 0xFF]++;
+        }
+        if (count == 0 || histogram[(keys[0] >> shift) & 0xFF] == count) continue; // Nothing to reorder
+
+        uint32_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+            uint32_t n = histogram[digit];
+            histogram[digit] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t slot = histogram[(keys[i] >> shift) & 0xFF]++;
+            keys_tmp[slot] = keys[i];
+            order_tmp[slot] = order[i];
+        }
+        keys.swap(keys_tmp);
+        order.swap(order_tmp);
+    }
+}
+
+void CrowdRenderer::record(DrawList& list, uint8_t layer) const {
+    for (const SpriteDraw& sprite : draw_list) {
+        const SpriteFrame& frame = *sprite.frame;
+        list.blit(layer, sprite.x, sprite.y, frame.width, frame.height,
+                  frame.data, frame.width, frame.height, 0, 0);
+    }
+}
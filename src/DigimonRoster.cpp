@@ -0,0 +1,24 @@
+#include "DigimonRoster.h"
+#include "animation_manifest_data.h" // Sprite sources and kDigimonRoster
+
+namespace {
+    // The generator precomputes the prefix sums; make sure they agree with the durations
+    constexpr bool clipTablesConsistent() {
+        for (int d = 0; d < DIGI_COUNT; ++d) {
+            for (int a = 0; a < ACTION_COUNT; ++a) {
+                const AnimClipDef& clip = kAnimClips[d][a];
+                uint32_t start = 0;
+                for (int i = 0; i < clip.frame_count; ++i) {
+                    int f = clip.first_frame + i;
+                    if (f >= ANIMATION_MANIFEST_FRAME_COUNT || kAnimFrameStartMs[f] != start) return false;
+                    if (kAnimFrameRefs[f].duration_ms == 0) return false;
+                    start += kAnimFrameRefs[f].duration_ms;
+                }
+                if (start != clip.total_ms) return false;
+            }
+            if (!hasAnimation(static_cast<DigimonType>(d), ACTION_IDLE) || !hasAnimation(static_cast<DigimonType>(d), ACTION_WALK)) return false;
+        }
+        return true;
+    }
+    static_assert(clipTablesConsistent(), "animation_manifest.h is inconsistent; re-run build_animation_manifest.py");
+}
@@ -0,0 +1,94 @@
+#include "EntityStore.h"
+
+static inline bool validClip(int digimon, int anim_action) {
+    return digimon >= 0 && digimon < DIGI_COUNT && anim_action >= 0 && anim_action < ACTION_COUNT;
+}
+
+void EntityStore::reserve(size_t count) {
+    pos_x.reserve(count);
+    pos_y.reserve(count);
+    speed_x.reserve(count);
+    digimon.reserve(count);
+    action.reserve(count);
+    clip.reserve(count);
+    repeat.reserve(count);
+    anim_start_ms.reserve(count);
+    frame_ref.reserve(count);
+    anim_cycles.reserve(count);
+}
+
+void EntityStore::clear() {
+    pos_x.clear();
+    pos_y.clear();
+    speed_x.clear();
+    digimon.clear();
+    action.clear();
+    clip.clear();
+    repeat.clear();
+    anim_start_ms.clear();
+    frame_ref.clear();
+    anim_cycles.clear();
+}
+
+size_t EntityStore::create(DigimonType type, AnimAction anim_action, float x, float y, float speed, uint32_t start_ms,
+                           bool repeat_clip) {
+    if (!validClip(type, anim_action)) { // Keep the kernel's clip lookups in bounds
+        type = validClip(type, ACTION_IDLE) ? type : DIGI_AGUMON;
+        anim_action = ACTION_IDLE;
+    }
+    size_t entity = size();
+    pos_x.push_back(x);
+    pos_y.push_back(y);
+    speed_x.push_back(speed);
+    digimon.push_back(static_cast<uint8_t>(type));
+    action.push_back(static_cast<uint8_t>(anim_action));
+    clip.push_back(static_cast<uint16_t>(type * ACTION_COUNT + anim_action));
+    repeat.push_back(repeat_clip ? 1 : 0);
+    anim_start_ms.push_back(start_ms);
+    frame_ref.push_back(kAnimClips[type][anim_action].first_frame);
+    anim_cycles.push_back(0);
+    return entity;
+}
+
+bool EntityStore::setAction(size_t entity, AnimAction anim_action, uint32_t start_ms) {
+    if (entity >= size() || !validClip(digimon[entity], anim_action)) return false;
+    action[entity] = static_cast<uint8_t>(anim_action);
+    clip[entity] = static_cast<uint16_t>(digimon[entity] * ACTION_COUNT + anim_action);
+    anim_start_ms[entity] = start_ms;
+    return true;
+}
+
+void EntityStore::updateAnimations(uint32_t now_ms) {
+    const AnimClipDef* clips = &kAnimClips[0][0];
+    const size_t count = size();
+    const uint16_t* clip_col = clip.data();
+    const uint8_t* repeat_col = repeat.data();
+    const uint32_t* start_col = anim_start_ms.data();
+    uint16_t* frame_col = frame_ref.data();
+    uint32_t* cycles_col = anim_cycles.data();
+
+    for (size_t i = 0; i < count; ++i) {
+        const AnimClipDef& def = clips[clip_col[i]];
+        Animation anim = makeAnimation(def, kAnimFrameRefs, kAnimFrameStartMs, nullptr);
+        anim.loops = anim.loops || repeat_col[i];
+        // Clips starting later than 'now_ms' hold their first frame instead of wrapping round
+        const int32_t elapsed = static_cast<int32_t>(now_ms - start_col[i]);
+        AnimSample sample = sampleAnimation(anim, elapsed > 0 ? static_cast<uint32_t>(elapsed) : 0);
+        frame_col[i] = static_cast<uint16_t>(def.first_frame + sample.frame);
+        cycles_col[i] = sample.cycles;
+    }
+}
+
+void EntityStore::updateMovement(float dt_frames, float world_width) {
+    const size_t count = size();
+    float* x_col = pos_x.data();
+    const float* speed_col = speed_x.data();
+
+    for (size_t i = 0; i < count; ++i) {
+        // Per-tick moves are far smaller than the world, so one conditional wrap is enough
+        float x = x_col[i] + speed_col[i] * dt_frames;
+        x = (x < 0.0f) ? x + world_width : x;
+        x = (x >= world_width) ? x - world_width : x;
+        x_col[i] = x;
+    }
+}
@@ -3,38 +3,161 @@
 #include "platform/IInput.h"
 #include "platform/pc/PCDisplay.h" // Include PC implementations FOR NOW
 #include "platform/pc/PCInput.h"   // to allow creating them
+#include "platform/pc/MonoDisplay.h"
+#include "platform/headless/HeadlessDisplay.h"
+#include "platform/headless/ReplayInput.h"
+#include "platform/PedometerInput.h"
+#include "AccelSource.h"
+#include "AssetManager.h"
+#include "ScanlineCompositor.h" // CompositorStats
+#include "RenderCounters.h"
+#include "castlebackground0.h"
+#include "castlebackground1.h"
+#include "castlebackground2.h"
 
 #include <SDL.h> // Still need SDL for GetTicks, Delay etc. FOR NOW
 #include <SDL_log.h>
-#include <cmath> // For fmod
+#include <algorithm> // std::min, std::max
+#include <stdio.h> // snprintf
 #include <stdexcept>
 
+// Milliseconds from 'start' to 'now', clamped at 0 for starts stamped later in the same loop
+static uint32_t elapsedSince(uint32_t start, uint32_t now) {
+    int32_t diff = static_cast<int32_t>(now - start);
+    return diff > 0 ? static_cast<uint32_t>(diff) : 0;
+}
+
+// Small deterministic LCG for crowd placement (same crowd every time it's spawned)
+static uint32_t nextCrowdRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Compiled-in art that scene files can name
+static const SceneImage kBuiltinSceneImages[] = {
+    {"castle_far", castlebackground2_data, CASTLEBACKGROUND2_WIDTH, CASTLEBACKGROUND2_HEIGHT},
+    {"castle_mid", castlebackground1_data, CASTLEBACKGROUND1_WIDTH, CASTLEBACKGROUND1_HEIGHT},
+    {"castle_fore", castlebackground0_data, CASTLEBACKGROUND0_WIDTH, CASTLEBACKGROUND0_HEIGHT},
+};
+static const size_t BUILTIN_SCENE_IMAGE_COUNT = sizeof(kBuiltinSceneImages) / sizeof(kBuiltinSceneImages[0]);
+
+// Used when no scene file could be loaded (same layout as assets/scenes/castle.scene)
+static const char* const kFallbackScene =
+    "layer far  castle_far  speed 0.5 wrap 947 z 0\n"
+    "layer mid  castle_mid  speed 1.0 wrap 947 z 1\n"
+    "sprites 2\n"
+    "layer fore castle_fore speed 3.0 wrap 947 z 3\n";
+
+#ifndef DIGIVICE_SCENE_DIR
+#define DIGIVICE_SCENE_DIR "assets/scenes"
+#endif
+#ifndef DIGIVICE_INPUT_BINDINGS
+#define DIGIVICE_INPUT_BINDINGS "assets/input.bindings"
+#endif
+
+// Replays need the interfaces: ReplayInput isn't the PC input class
+static bool replaysInput(const GameOptions& options) {
+#ifdef DIGIVICE_STATIC_PLATFORM
+    (void)options; // main() refuses --replay in this build
+    return false;
+#else
+    return !options.replay_path.empty();
+#endif
+}
+
 // --- Game Constructor ---
-Game::Game() :
+Game::Game(const GameOptions& options) :
     display(nullptr),
     input(nullptr),
+    assets(nullptr),
     isRunning(false),
-    bg_data_0(castlebackground0_data),
-    bg_data_1(castlebackground1_data),
-    bg_data_2(castlebackground2_data),
-    bg_scroll_offset_0(0.0f),
-    bg_scroll_offset_1(0.0f),
-    bg_scroll_offset_2(0.0f),
+    loop_wakeups(0),
+    loop_stats_start(0),
+    loop_stats_frames(0),
+    governor(),
+    present_ticks(0),
+    clock(replaysInput(options)),
+    record_path(options.record_path),
+    recorder(),
+    headless_display(nullptr),
+    replay_hash(2166136261u),
+    input_pressed_at(0),
+    input_frame(0),
+    select_pressed_at(0),
+    bindings_path(DIGIVICE_INPUT_BINDINGS),
+    scene_paths{DIGIVICE_SCENE_DIR "/castle.scene", DIGIVICE_SCENE_DIR "/ramparts.scene"},
+    current_scene(0),
     current_state(STATE_IDLE),
     current_digimon(DIGI_AGUMON),
-    active_anim(nullptr),
+    pending_digimon(DIGI_COUNT),
+    current_assets(nullptr),
+    active_anim(),
     current_anim_frame_idx(0),
-    last_anim_update_time(0),
-    queued_steps(0)
+    anim_start_time(0),
+    queued_steps(0),
+    current_action(ACTION_IDLE),
+    crowd_mode(false),
+    crowd_pinned(false),
+    crowd_neighbours{DIGI_COUNT, DIGI_COUNT},
+    frame_list(MAX_FRAME_DRAWS),
+    frames_rendered(0),
+    heat_map(false),
+    drawn_valid(false),
+    drawn_hero{nullptr, nullptr, 0, 0, 0}
 {
     // Create the platform-specific objects using concrete types for now
-    display = new PCDisplay();
+#ifdef DIGIVICE_STATIC_PLATFORM
+    display = new PCDisplay(options.render_thread); // main() refuses --mono, --headless and --accel here
     input = new PCInput();
+#else
+    if (options.headless && !clock.isVirtual()) SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Headless runs replay a recording; opening a window");
+    if (options.monochrome && options.render_thread) SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "The monochrome LCD mode draws on the main thread");
+    if (options.headless && clock.isVirtual()) {
+        display = headless_display = new HeadlessDisplay();
+    } else if (options.monochrome) {
+        display = new MonoDisplay();
+    } else {
+        display = new PCDisplay(options.render_thread);
+    }
+
+    if (clock.isVirtual()) {
+        InputRecording recording;
+        if (loadInputRecording(options.replay_path.c_str(), recording)) { // input stays null otherwise: initialize() fails
+            SDL_Log("Replaying %zu input frames (%u ms) from %s", recording.frames.size(), recording.end_ms,
+                    options.replay_path.c_str());
+            input = new ReplayInput(recording, clock);
+        }
+    } else if (!options.accel_path.empty()) {
+        // Steps from an accelerometer (a replay has their counts recorded already)
+        AccelSource* source = nullptr;
+        if (options.accel_path == "synthetic") {
+            source = new SyntheticAccelSource(options.accel_rate_hz);
+        } else {
+            CsvAccelSource* csv = new CsvAccelSource(options.accel_rate_hz);
+            if (csv->open(options.accel_path.c_str())) source = csv;
+            else {
+                SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s: cannot open", options.accel_path.c_str());
+                delete csv; // input stays null: initialize() fails
+            }
+        }
+        if (source) input = new PedometerInput(new PCInput(), source, clock);
+    } else {
+        input = new PCInput();
+    }
+#endif
+
+    std::vector<AssetSource> sources(DIGI_COUNT);
+    for (int i = 0; i < DIGI_COUNT; ++i) {
+        sources[i].frames = kDigimonRoster[i].sprites;
+        sources[i].frame_count = kDigimonRoster[i].sprite_count;
+    }
+    assets = new AssetManager(sources, ASSET_CACHE_BUDGET_BYTES);
 }
 
 // --- Game Destructor ---
 Game::~Game() {
-    delete display;
+    delete display; // First: a render thread may still be drawing sprites from 'assets'
+    delete assets;
     delete input;
 }
 
@@ -54,35 +177,221 @@ bool Game::initialize() {
         return false;
     }
     // Note: Input doesn't have an init method currently
+    if (!record_path.empty()) {
+        if (!recorder.open(record_path.c_str())) return false;
+        SDL_Log("Recording input to %s", record_path.c_str());
+    }
+    if (!bindings_path.empty() && !input->loadBindings(bindings_path.c_str())) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "Keeping the default key bindings");
+    }
+
+    if (!loadScenes()) return false;
 
     // Set up initial game state (moved from old main)
-    setupAnimations(); // Setup animation objects first
     current_state = STATE_IDLE;
     current_digimon = DIGI_AGUMON;
+    pending_digimon = DIGI_COUNT;
     queued_steps = 0;
-    selectActiveAnimation(true); // Then select the starting animation
-
-    last_anim_update_time = SDL_GetTicks(); // Initialize time
+    current_assets = assets->pinAndLoad(current_digimon); // Only the starting Digimon is loaded up front
+    if (!current_assets) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load starting Digimon!");
+        return false;
+    }
+    selectActiveAnimation(true, clock.now()); // Select the starting animation
+    crowd_renderer.setViewport(WINDOW_WIDTH, WINDOW_HEIGHT);
+    crowd_renderer.setCameraX(CROWD_SPRITE_MARGIN);
 
     isRunning = true;
     SDL_Log("--- Game Initialized Successfully ---");
     return true;
 }
 
+// --- Load Every Scene File Up Front ---
+bool Game::loadScenes() {
+    scenes.clear();
+    for (const std::string& path : scene_paths) {
+        ParallaxScene scene;
+        if (!scene.load(path.c_str(), kBuiltinSceneImages, BUILTIN_SCENE_IMAGE_COUNT)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Scene not loaded: %s", scene.error().c_str());
+            continue;
+        }
+        SDL_Log("Loaded scene '%s' (%zu layers)", scene.name().c_str(), scene.layerCount());
+        scenes.push_back(std::move(scene));
+    }
+    if (scenes.empty()) {
+        ParallaxScene fallback;
+        if (!fallback.parse(kFallbackScene, "castle", "", kBuiltinSceneImages, BUILTIN_SCENE_IMAGE_COUNT)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Built-in scene failed: %s", fallback.error().c_str());
+            return false;
+        }
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "No scene files loaded, using the built-in castle");
+        scenes.push_back(std::move(fallback));
+    }
+
+    // Every tile of the busiest scene and the crowd must fit the frame's draw list
+    size_t draws = 0;
+    for (const ParallaxScene& scene : scenes) {
+        draws = std::max(draws, scene.maxBlits(WINDOW_WIDTH) + CROWD_SIZE);
+    }
+    if (draws > frame_list.capacity()) frame_list = DrawList(draws);
+
+    // Scrolling layers: let the display keep them converted, wrapping at each one's period
+    for (const ParallaxScene& scene : scenes) {
+        for (size_t i = 0; i < scene.layerCount(); ++i) {
+            const SceneLayer& layer = scene.layer(i);
+            if (!display->cacheLayer(layer.pixels, layer.width, layer.height, layer.wrap)) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Scene '%s': layer '%s' wraps its art at %d, but another layer "
+                            "wraps it differently; the display keeps the first layout", scene.name().c_str(),
+                            layer.name.c_str(), layer.wrap);
+            }
+        }
+    }
+    selectScene(0);
+    return true;
+}
+
+void Game::selectScene(size_t index) {
+    current_scene = index % scenes.size();
+    drawn_valid = false; // Everything on screen changes
+    SDL_Log("Scene: %s", scenes[current_scene].name().c_str());
+}
+
 // --- Main Game Loop ---
+// Frames are only produced when something can have changed. While the scene scrolls or the
+// crowd walks that is every frame; otherwise the loop sleeps in the input queue until the
+// hero's next frame switch (or the next stats log), so an idle Digimon costs a wakeup or two
+// per second and a key press is still handled as soon as it arrives.
 void Game::run() {
     SDL_Log("--- Entering Game Loop ---");
+    loop_stats_start = clock.now();
+    loop_stats_frames = frames_rendered;
+    const double counter_ms = 1000.0 / SDL_GetPerformanceFrequency();
+    const Uint64 run_start = SDL_GetPerformanceCounter();
+    const uint32_t run_start_ms = clock.now();
     while (isRunning) {
-        Uint32 currentTime = SDL_GetTicks(); // Use SDL_GetTicks for now
+        Uint32 currentTime = clock.now();
+        Uint64 work_start = SDL_GetPerformanceCounter();
+        present_ticks = 0;
+        uint32_t drawn_before = frames_rendered;
 
         handleInput();       // Process inputs
         update(currentTime); // Update game logic
-        render();            // Draw the frame
+        render();            // Draw the frame (skipped if nothing changed)
+        if (!isRunning) break;
+        if (display->framePending()) showFrame(frames_rendered); // Render thread finished a frame since
+        unpinShownCharacters();
+
+        // Only frames drawn at the steady cadence tell the governor anything (the heat map is a slow debug path).
+        // A replay's frames take no game time, and must come out the same whatever the machine.
+        if (frames_rendered != drawn_before && animatesEveryFrame() && !heat_map && !clock.isVirtual()) {
+            float work_ms = static_cast<float>((SDL_GetPerformanceCounter() - work_start - present_ticks) * counter_ms);
+            QualityLevel was = governor.level();
+            if (governor.addFrame(work_ms, static_cast<float>(frameIntervalMs()))) {
+                SDL_Log("Quality: %s -> %s (frames used %.0f%% of their time)", qualityLevelName(was),
+                        qualityLevelName(governor.level()), governor.lastLoad() * 100.0f);
+                applyQuality();
+            }
+        }
+
+        uint32_t now = clock.now();
+        loop_wakeups++;
+        if (elapsedSince(loop_stats_start, now) >= LOOP_STATS_INTERVAL_MS) logLoopStats(now);
 
-        // Frame Limiter
-        SDL_Delay(16); // Aim for ~60 FPS
+        if (animatesEveryFrame()) {
+            // Frame Limiter: scrolling and crowd movement advance one step per FRAME_INTERVAL_MS
+            uint32_t spent = elapsedSince(currentTime, now);
+            if (spent < frameIntervalMs()) clock.sleep(frameIntervalMs() - spent);
+        } else {
+            input->waitForInput(msUntilNextChange(now));
+        }
     }
      SDL_Log("--- Exited Game Loop ---");
+
+    if (recorder.isOpen()) {
+        SDL_Log("Recorded %u input frames to %s", recorder.framesRecorded(), record_path.c_str());
+        recorder.finish(clock.now());
+    }
+    if (clock.isVirtual()) {
+        // The standard workload timing: same frames every run, so only the build differs
+        double wall_ms = (SDL_GetPerformanceCounter() - run_start) * counter_ms;
+        uint32_t played_ms = elapsedSince(run_start_ms, clock.now());
+        SDL_Log("Replay: %u frames, %u ms of play in %.1f ms (%.1fx real time)", frames_rendered, played_ms, wall_ms,
+                wall_ms > 0.0 ? played_ms / wall_ms : 0.0);
+        if (headless_display) SDL_Log("Replay frame hash %08x", static_cast<unsigned>(replay_hash));
+    }
+}
+
+// --- Helper: Whether the Next Frame Differs Whatever the Clock Says ---
+bool Game::animatesEveryFrame() const {
+    return crowd_mode || current_state == STATE_WALKING || queued_steps > 0 ||
+           pending_digimon != DIGI_COUNT; // Polling for the load to finish
+}
+
+// --- Helper: Frame Cadence, Longer at Reduced Frame Rates ---
+uint32_t Game::frameIntervalMs() const {
+    return governor.level() >= QUALITY_HALF_FRAME_RATE ? 2 * FRAME_INTERVAL_MS : FRAME_INTERVAL_MS;
+}
+
+// --- Helper: Apply the Governor's Quality Level to the Scenes and the Display ---
+void Game::applyQuality() {
+    QualityLevel level = governor.level();
+    for (ParallaxScene& scene : scenes) scene.setFarLayersHidden(level >= QUALITY_NO_FAR_LAYERS);
+    display->setCompositionRowStep(level >= QUALITY_HALF_RESOLUTION ? 2 : 1);
+    drawn_valid = false; // The whole picture changes
+}
+
+// --- Helper: Time Until the Hero's Next Frame Switch or the Next Stats Log ---
+uint32_t Game::msUntilNextChange(uint32_t now) const {
+    uint32_t wait = LOOP_STATS_INTERVAL_MS - std::min(elapsedSince(loop_stats_start, now), LOOP_STATS_INTERVAL_MS);
+    if (!active_anim.empty() && active_anim.total_duration > 0) {
+        uint32_t elapsed = elapsedSince(anim_start_time, now);
+        if (active_anim.loops || elapsed < active_anim.total_duration) { // Finished one-shots hold their last frame
+            int frame = sampleAnimation(active_anim, elapsed).frame;
+            uint32_t next_start = frame + 1 < active_anim.frame_count ? active_anim.frameStart(frame + 1)
+                                                                     : active_anim.total_duration;
+            wait = std::min(wait, next_start - elapsed % active_anim.total_duration);
+        }
+    }
+    return std::max<uint32_t>(wait, 1); // Never spin on a deadline that is due right now
+}
+
+// --- Helper: Present, Timed Apart from the Frame's Work ---
+// present() blocks until vsync, so its time is kept out of the load the governor sees.
+void Game::showFrame(uint32_t submitted) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    display->present();
+    present_ticks += SDL_GetPerformanceCounter() - start;
+    notePresented(submitted);
+}
+
+// --- Helper: Finish the Latency Measurement Once the Press's Frame Is on Screen ---
+// 'submitted': frames handed to the display so far. Headless replays also fold the frame
+// into the replay hash here.
+void Game::notePresented(uint32_t submitted) {
+    if (headless_display) replay_hash = (replay_hash ^ headless_display->frameHash()) * 16777619u;
+    if (input_pressed_at == 0 || input_frame == 0 || display->framesShown(submitted) < input_frame) return;
+    double ms = (SDL_GetPerformanceCounter() - input_pressed_at) * 1000.0 / SDL_GetPerformanceFrequency();
+    input_latency.add(ms);
+    input_pressed_at = 0;
+}
+
+// --- Helper: Log How Often the Loop Woke Up and Drew ---
+void Game::logLoopStats(uint32_t now) {
+    float seconds = elapsedSince(loop_stats_start, now) / 1000.0f;
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Loop: %.1f wakeups/s, %.1f frames drawn/s",
+                 loop_wakeups / seconds, (frames_rendered - loop_stats_frames) / seconds);
+    LatencySummary latency = input_latency.summary();
+    if (latency.count > 0) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Input to present: p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms (last %zu presses)",
+                     latency.p50, latency.p95, latency.p99, latency.max, latency.count);
+    }
+    if (input->getShakeCount() > 0) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Pedometer: %u steps, cadence %u steps/min", input->getShakeCount(),
+                     input->getCadence());
+    }
+    loop_wakeups = 0;
+    loop_stats_start = now;
+    loop_stats_frames = frames_rendered;
 }
 
 // --- Handle User Input ---
@@ -90,50 +399,68 @@ void Game::handleInput() {
     if (!input) return;
 
     input->update(); // This now polls SDL events inside PCInput
+    recorder.record(clock.now(), input->actions(), input->stepsPressed()); // No-op unless recording
 
     if (input->isQuitRequested()) {
         isRunning = false;
         return;
     }
 
-    // Check for step action (using the interface method)
-    if (input->wasActionPressed(InputAction::STEP)) {
-        if (queued_steps < MAX_QUEUED_STEPS) {
-            queued_steps++;
-             SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Step Action Pressed (%d queued)", queued_steps);
-        }
+    // Presses that change what's on screen start an input-to-present latency measurement
+    bool reacted = false;
+
+    // Every action's state in one query; the checks below are bit tests
+    const InputState state = input->actions();
+    auto pressed = [&state](InputAction action) { return (state.pressed & actionBit(action)) != 0; };
+
+    // One step per STEP press; a pedometer can deliver several in a frame. Steps past a full
+    // queue are dropped, pedometer or key: the walk never runs more than MAX_QUEUED_STEPS
+    // cycles behind the feet
+    for (uint32_t steps = input->stepsPressed(); steps > 0 && queued_steps < MAX_QUEUED_STEPS; --steps) {
+        queued_steps++;
+        reacted = true;
+         SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Step Action Pressed (%d queued)", queued_steps);
     }
 
-    // Check for Digimon selection (using the interface method)
-    InputAction selections[] = {
-        InputAction::SELECT_DIGI_1, InputAction::SELECT_DIGI_2, InputAction::SELECT_DIGI_3,
-        InputAction::SELECT_DIGI_4, InputAction::SELECT_DIGI_5, InputAction::SELECT_DIGI_6,
-        InputAction::SELECT_DIGI_7, InputAction::SELECT_DIGI_8
-    };
-    bool character_changed_this_frame = false; // Track if change happened
-    for(int i = 0; i < DIGI_COUNT; ++i) {
-        if (input->wasActionPressed(selections[i])) {
-            DigimonType selected_digi = static_cast<DigimonType>(i);
-             if (selected_digi != current_digimon) {
-                 current_digimon = selected_digi; SDL_Log("Switched character to %d", current_digimon);
-                 current_state = STATE_IDLE; // Force idle on switch
-                 queued_steps = 0; // Reset steps on switch
-                 character_changed_this_frame = true; // Flag for animation reset
-             }
-             break; // Only process one selection per frame
-        }
+    // Check for Digimon selection: next/previous in the roster, from the one still loading if any
+    const int select_step = (pressed(InputAction::SELECT_NEXT) ? 1 : 0) - (pressed(InputAction::SELECT_PREV) ? 1 : 0);
+    if (select_step != 0) {
+        const int from = (pending_digimon != DIGI_COUNT) ? pending_digimon : current_digimon;
+        const DigimonType target = static_cast<DigimonType>((from + select_step + DIGI_COUNT) % DIGI_COUNT);
+        // Its effect is the new Digimon on screen, once loaded: completePendingSwitch() starts
+        // the measurement then, so frames still showing the old one don't end it
+        if (target != current_digimon && target != pending_digimon) select_pressed_at = input->pressTimestamp();
+        requestDigimon(target);
     }
-    // Reset animation if character changed
-    if (character_changed_this_frame) {
-        selectActiveAnimation(true);
+    if (pressed(InputAction::TOGGLE_CROWD)) {
+        reacted = true;
+        setCrowdMode(!crowd_mode, clock.now());
     }
+    if (pressed(InputAction::TOGGLE_HEATMAP)) {
+        reacted = true;
+        heat_map = !heat_map;
+        display->setHeatMap(heat_map);
+        drawn_valid = false; // Tint the whole frame, or take the tint off
+        SDL_Log("Overdraw heat map %s", heat_map ? "on" : "off");
+    }
+    if (pressed(InputAction::NEXT_SCENE)) {
+        reacted = true;
+        selectScene(current_scene + 1);
+    }
+    if (reacted && input_pressed_at == 0 && input->pressTimestamp() != 0) {
+        input_pressed_at = input->pressTimestamp();
+        input_frame = 0; // Not drawn yet
+    }
+    // Switch over once the requested Digimon's frames are resident (never blocks)
+    completePendingSwitch();
 }
 
 // --- Update Game Logic ---
-void Game::update(Uint32 currentTime) {
+void Game::update(uint32_t currentTime) {
     bool needsAnimReset = false; // Track if animation needs changing this frame
 
     // --- State Transitions based on Input/Queue ---
+    uint32_t animStartTime = currentTime; // Start of whatever clip gets selected below
     if (current_state == STATE_IDLE && queued_steps > 0) {
         current_state = STATE_WALKING;
         needsAnimReset = true;
@@ -141,107 +468,175 @@ void Game::update(Uint32 currentTime) {
     }
 
     // --- Update Scrolling based on State ---
+    // Movement is in FRAME_INTERVAL_MS steps, so it keeps its speed at reduced frame rates
+    float steps = static_cast<float>(frameIntervalMs()) / FRAME_INTERVAL_MS;
     if (current_state == STATE_WALKING) {
-        // Layer 0
-        bg_scroll_offset_0 -= SCROLL_SPEED_0;
-        while (bg_scroll_offset_0 < 0.0f) { bg_scroll_offset_0 += effectiveW_float_0; }
-        bg_scroll_offset_0 = std::fmod(bg_scroll_offset_0, effectiveW_float_0);
-        // Layer 1
-        bg_scroll_offset_1 -= SCROLL_SPEED_1;
-        while (bg_scroll_offset_1 < 0.0f) { bg_scroll_offset_1 += effectiveW_float_1; }
-        bg_scroll_offset_1 = std::fmod(bg_scroll_offset_1, effectiveW_float_1);
-        // Layer 2
-        bg_scroll_offset_2 -= SCROLL_SPEED_2;
-        while (bg_scroll_offset_2 < 0.0f) { bg_scroll_offset_2 += effectiveW_float_2; }
-        bg_scroll_offset_2 = std::fmod(bg_scroll_offset_2, effectiveW_float_2);
+        scenes[current_scene].scroll(steps);
     }
 
     // --- Animation Logic ---
-    bool animation_cycle_finished = false;
-    if (active_anim && !active_anim->frames.empty() && !active_anim->frame_durations_ms.empty()) {
-         if (current_anim_frame_idx >= active_anim->frames.size() || current_anim_frame_idx >= active_anim->frame_durations_ms.size()) {
-             current_anim_frame_idx = 0; // Reset if out of bounds
-         }
-
-         Uint32 current_frame_duration = active_anim->frame_durations_ms[current_anim_frame_idx];
-         if (currentTime >= last_anim_update_time + current_frame_duration) {
-             current_anim_frame_idx++;
-             last_anim_update_time = currentTime;
-
-             if (current_anim_frame_idx >= active_anim->frames.size()) {
-                 animation_cycle_finished = true;
-                 if (active_anim->loops) {
-                     current_anim_frame_idx = 0; // Loop
-                 } else {
-                     current_anim_frame_idx = active_anim->frames.size() - 1; // Stay on last frame
-                     if (current_anim_frame_idx < 0) current_anim_frame_idx = 0;
-                 }
-             }
-         }
-    } else {
-        current_anim_frame_idx = 0;
-    }
+    // Sample by elapsed time rather than stepping one frame per loop, so a hitch can't desync it
+    AnimSample sample = sampleAnimation(active_anim, elapsedSince(anim_start_time, currentTime));
+    current_anim_frame_idx = sample.frame;
 
     // --- State Transitions based on Animation ---
-     if (current_state == STATE_WALKING && animation_cycle_finished && !active_anim->loops) {
-         queued_steps--; SDL_Log("Walk cycle finished. Steps remaining: %d", queued_steps);
-         if (queued_steps > 0) { // Still steps left, restart walk animation
-             current_anim_frame_idx = 0;
-             last_anim_update_time = currentTime; // Reset timer for new cycle
-             animation_cycle_finished = false;
-             SDL_Log("Starting next queued walk cycle.");
-             // Needs animation reset, but state stays WALKING
-             needsAnimReset = true; // Signal to re-select walk animation (and reset its frame)
-         } else { // No steps left, transition to idle
-             SDL_Log("Switching to IDLE state.");
-             current_state = STATE_IDLE;
-             needsAnimReset = true; // Signal to select idle animation
-         }
-     }
+    // Each completed walk cycle is one step; after a long stall several may complete at once
+    if (current_state == STATE_WALKING && sample.cycles > 0) {
+        int steps_done = static_cast<int>(sample.cycles < static_cast<uint32_t>(queued_steps) ? sample.cycles : queued_steps);
+        uint32_t walk_end_time = anim_start_time + steps_done * active_anim.total_duration;
+        queued_steps -= steps_done;
+        SDL_Log("Walk cycle finished. Steps remaining: %d", queued_steps);
+        if (queued_steps > 0) { // Still steps left, carry on into the next cycle without losing time
+            anim_start_time = walk_end_time;
+            current_anim_frame_idx = sampleAnimation(active_anim, elapsedSince(anim_start_time, currentTime)).frame;
+            SDL_Log("Starting next queued walk cycle.");
+        } else { // No steps left, transition to idle as of when the last cycle actually ended
+            SDL_Log("Switching to IDLE state.");
+            current_state = STATE_IDLE;
+            needsAnimReset = true;
+            animStartTime = walk_end_time;
+        }
+    }
 
     // --- Select correct animation if needed ---
     if (needsAnimReset) {
-        selectActiveAnimation(true); // Force reset timing etc.
+        selectActiveAnimation(true, animStartTime);
+        current_anim_frame_idx = sampleAnimation(active_anim, elapsedSince(anim_start_time, currentTime)).frame;
     }
+
+    if (crowd_mode) updateCrowd(currentTime, steps);
 }
 
 // --- Render the Game Frame ---
 void Game::render() {
     if (!display) return;
 
-    display->clear(0x0000); // Use interface pointer
-
-    // --- Draw Background Layers ---
-    int draw2_x1 = -static_cast<int>(bg_scroll_offset_2);
-    int draw2_x2 = draw2_x1 + EFFECTIVE_BG_WIDTH_2;
-    drawClippedTile(draw2_x1, bg_data_2, TILE_WIDTH_2, TILE_HEIGHT_2);
-    drawClippedTile(draw2_x2, bg_data_2, TILE_WIDTH_2, TILE_HEIGHT_2);
-
-    int draw1_x1 = -static_cast<int>(bg_scroll_offset_1);
-    int draw1_x2 = draw1_x1 + EFFECTIVE_BG_WIDTH_1;
-    drawClippedTile(draw1_x1, bg_data_1, TILE_WIDTH_1, TILE_HEIGHT_1);
-    drawClippedTile(draw1_x2, bg_data_1, TILE_WIDTH_1, TILE_HEIGHT_1);
+    // Sprites evicted since the last frame: a sprite loaded since may sit at the same address,
+    // so the backend drops what it derived from the old one before this frame is submitted
+    if (assets) {
+        assets->takeEvicted(evicted_sprites);
+        for (const uint16_t* pixels : evicted_sprites) display->forgetSource(pixels);
+    }
 
-    // --- Draw Character Sprite ---
-    if (active_anim && current_anim_frame_idx < active_anim->frames.size()) {
-        const SpriteFrame& frame = active_anim->frames[current_anim_frame_idx];
+    // Record the whole frame, then hand it to the backend in one go
+    frame_list.reset();
+    frame_list.setClip(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+    ParallaxScene& scene = scenes[current_scene];
+    frame_list.clear(scene.clearColor());
+
+    // --- Draw the Scene's Layers (those in front of the characters land on later draw layers) ---
+    bool scene_moved = scene.record(frame_list, WINDOW_WIDTH, WINDOW_HEIGHT);
+
+    // --- Draw Character Sprite(s) ---
+    HeroDraw hero = {nullptr, nullptr, 0, 0, 0};
+    if (crowd_mode) {
+        crowd_renderer.record(frame_list, scene.spriteLayer()); // Already culled and y-sorted in updateCrowd()
+    } else if (!active_anim.empty() && current_anim_frame_idx < active_anim.frame_count) {
+        const SpriteFrame& frame = active_anim.frame(current_anim_frame_idx);
         if (frame.data) {
             int draw_x = (WINDOW_WIDTH / 2) - (frame.width / 2);
             int draw_y = (WINDOW_HEIGHT / 2) - (frame.height / 2);
             // int draw_y = WINDOW_HEIGHT - frame.height - 10; // Align bottom example
-            display->drawPixels(draw_x, draw_y, frame.width, frame.height,
-                               frame.data, frame.width, frame.height, 0, 0);
+            frame_list.blit(scene.spriteLayer(), draw_x, draw_y, frame.width, frame.height,
+                            frame.data, frame.width, frame.height, 0, 0);
+            hero = {&frame, active_anim.frame_refs, current_anim_frame_idx, draw_x, draw_y};
         }
     }
 
-    // --- Draw Foreground Layer ---
-    int draw0_x1 = -static_cast<int>(bg_scroll_offset_0);
-    int draw0_x2 = draw0_x1 + EFFECTIVE_BG_WIDTH_0;
-    drawClippedTile(draw0_x1, bg_data_0, TILE_WIDTH_0, TILE_HEIGHT_0);
-    drawClippedTile(draw0_x2, bg_data_0, TILE_WIDTH_0, TILE_HEIGHT_0);
+    if (frame_list.droppedCount() > 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Frame draw list full: %zu blits dropped", frame_list.droppedCount());
+    }
+    if (!recordDamage(scene_moved, hero)) return; // Same frame as on screen: nothing to draw
+
+    // --- Execute and present the final frame ---
+    if (input_pressed_at != 0 && input_frame == 0) input_frame = frames_rendered + 1; // This frame shows the press
+    display->submit(frame_list);
+    showFrame(frames_rendered + 1);
 
-    // --- Present the final frame ---
-    display->present(); // Use interface pointer
+    if (++frames_rendered % STATS_LOG_INTERVAL_FRAMES == 0) logFrameStats();
+}
+
+// --- Helper: Tell the Backend Which Part of the Screen Changed Since the Last Frame ---
+// Only the hero's animation can change while the backgrounds hold still: a frame step in
+// play order redraws the rect baked into the manifest (kAnimFrameDiffs), anything else the
+// old and new sprite rects. Scrolling, the crowd and any change under the heat map (whose
+// tint covers the whole frame) redraw everything. Returns false if the frame is the one
+// already on screen.
+bool Game::recordDamage(bool scene_moved, const HeroDraw& hero) {
+    bool changed = true;
+    bool full = !drawn_valid || crowd_mode || scene_moved;
+
+    const HeroDraw& last = drawn_hero;
+    bool same_place = hero.frame && last.frame && hero.x == last.x && hero.y == last.y &&
+                      hero.frame->width == last.frame->width && hero.frame->height == last.frame->height;
+    if (!full && same_place && hero.frame->data == last.frame->data) {
+        frame_list.setDamage(0, 0, 0, 0); // Nothing changed
+        changed = false;
+    } else if (full || heat_map) {
+        // No damage rect: the backend redraws the whole frame
+    } else if (same_place && hero.clip == last.clip && active_anim.frame_diffs &&
+               last.clip_frame == active_anim.previousFrame(hero.clip_frame)) {
+        const AnimFrameDiff& diff = active_anim.frame_diffs[hero.clip_frame];
+        frame_list.setDamage(hero.x + diff.x, hero.y + diff.y, diff.w, diff.h);
+    } else {
+        int x0 = WINDOW_WIDTH, y0 = WINDOW_HEIGHT, x1 = 0, y1 = 0;
+        for (const HeroDraw* draw : {&hero, &last}) {
+            if (!draw->frame) continue;
+            x0 = std::min(x0, draw->x);
+            y0 = std::min(y0, draw->y);
+            x1 = std::max(x1, draw->x + draw->frame->width);
+            y1 = std::max(y1, draw->y + draw->frame->height);
+        }
+        frame_list.setDamage(x0, y0, x1 - x0, y1 - y0);
+    }
+
+    // The crowd isn't tracked, so the frame after it is redrawn in full too
+    drawn_valid = !crowd_mode;
+    drawn_hero = hero;
+    return changed;
+}
+
+// --- Helper: Log the Last Frame's Render Counters / Compositor Coverage Report ---
+void Game::logFrameStats() {
+    // Draw layer i is the characters or one of the scene's layers
+    const ParallaxScene& scene = scenes[current_scene];
+    auto layerLabel = [&scene](size_t i) -> const char* {
+        if (i == scene.spriteLayer()) return "characters";
+        return scene.layer(i < scene.spriteLayer() ? i : i - 1).name.c_str();
+    };
+    const RenderCounters* counters = display->renderCounters();
+    if (counters) {
+        // One "name read/written" entry per scene layer, characters at their depth
+        std::string layers;
+        uint32_t blits = 0;
+        for (size_t i = 0; i <= scene.layerCount(); ++i) {
+            int slot = renderStatsSlot(static_cast<int>(i));
+            char entry[96];
+            snprintf(entry, sizeof(entry), "%s%s %llu/%llu", layers.empty() ? "" : ", ", layerLabel(i),
+                         static_cast<unsigned long long>(counters->pixels_read[slot]),
+                         static_cast<unsigned long long>(counters->pixels_written[slot]));
+            layers += entry;
+        }
+        for (int slot = 0; slot < RENDER_STATS_LAYERS; ++slot) blits += counters->blits[slot];
+        SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "Pixels read/written: %s, cleared %llu",
+                     layers.c_str(), static_cast<unsigned long long>(counters->pixels_cleared));
+        SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "Upload: %llu bytes, %u texture locks, %u blits",
+                     static_cast<unsigned long long>(counters->bytes_uploaded), counters->texture_locks, blits);
+    }
+
+    const CompositorStats* stats = display->compositorStats();
+    if (!stats) return;
+    std::string coverage;
+    for (size_t i = 0; i <= scene.layerCount(); ++i) {
+        char entry[64];
+        snprintf(entry, sizeof(entry), "%s %.1f%%, ", layerLabel(i),
+                     stats->coverage(stats->layer_written[renderStatsSlot(static_cast<int>(i))]));
+        coverage += entry;
+    }
+    SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "Compositor: %.2f layers touched/pixel (painter's algorithm: %.2f), %u blits culled",
+                 stats->layersTouchedPerPixel(), stats->painterLayersPerPixel(), stats->blits_culled);
+    SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "Coverage: %scleared %.1f%%, hidden px skipped %llu",
+                 coverage.c_str(), stats->coverage(stats->pixels_cleared), static_cast<unsigned long long>(stats->pixels_hidden));
 }
 
 // --- Cleanup Game Systems ---
@@ -251,137 +646,174 @@ void Game::cleanup() {
         display->close(); // Close display via interface
     }
     // Input cleanup might be added later if needed
+    if (assets) {
+        // The display is closed: nothing draws the sprites any more
+        for (const PendingUnpin& pending : pending_unpins) assets->unpin(pending.digimon);
+        pending_unpins.clear();
+        releaseCrowdAssets();
+        assets->unpin(current_digimon);
+        if (pending_digimon != DIGI_COUNT) assets->unpin(pending_digimon);
+        current_assets = nullptr;
+        pending_digimon = DIGI_COUNT;
+    }
     SDL_Quit(); // Quit SDL subsystems here, after display is closed
      SDL_Log("--- Game Cleanup Finished ---");
 }
 
-// --- Helper: Setup Animation Objects ---
-void Game::setupAnimations() {
-     // This logic is identical to your old main.cpp, just inside the Game class
-     SpriteFrame agumon_idle_0_sf = {AGUMON_IDLE_0_WIDTH, AGUMON_IDLE_0_HEIGHT, Agumon_Idle_0_data};
-     SpriteFrame agumon_idle_1_sf = {AGUMON_IDLE_1_WIDTH, AGUMON_IDLE_1_HEIGHT, Agumon_Idle_1_data};
-     SpriteFrame agumon_walk_0_sf = {AGUMON_WALK_0_WIDTH, AGUMON_WALK_0_HEIGHT, Agumon_Walk_0_data};
-     SpriteFrame agumon_walk_1_sf = {AGUMON_WALK_1_WIDTH, AGUMON_WALK_1_HEIGHT, Agumon_Walk_1_data};
-     SpriteFrame gabumon_idle_0_sf = {GABUMON_IDLE_0_WIDTH, GABUMON_IDLE_0_HEIGHT, Gabumon_Idle_0_data};
-     SpriteFrame gabumon_idle_1_sf = {GABUMON_IDLE_1_WIDTH, GABUMON_IDLE_1_HEIGHT, Gabumon_Idle_1_data};
-     SpriteFrame gabumon_walk_0_sf = {GABUMON_WALK_0_WIDTH, GABUMON_WALK_0_HEIGHT, Gabumon_Walk_0_data};
-     SpriteFrame gabumon_walk_1_sf = {GABUMON_WALK_1_WIDTH, GABUMON_WALK_1_HEIGHT, Gabumon_Walk_1_data};
-     SpriteFrame biyomon_idle_0_sf = {BIYOMON_IDLE_0_WIDTH, BIYOMON_IDLE_0_HEIGHT, Biyomon_Idle_0_data};
-     SpriteFrame biyomon_idle_1_sf = {BIYOMON_IDLE_1_WIDTH, BIYOMON_IDLE_1_HEIGHT, Biyomon_Idle_1_data};
-     SpriteFrame biyomon_walk_0_sf = {BIYOMON_WALK_0_WIDTH, BIYOMON_WALK_0_HEIGHT, Biyomon_Walk_0_data};
-     SpriteFrame biyomon_walk_1_sf = {BIYOMON_WALK_1_WIDTH, BIYOMON_WALK_1_HEIGHT, Biyomon_Walk_1_data};
-     SpriteFrame gatomon_idle_0_sf = {GATOMON_IDLE_0_WIDTH, GATOMON_IDLE_0_HEIGHT, Gatomon_Idle_0_data};
-     SpriteFrame gatomon_idle_1_sf = {GATOMON_IDLE_1_WIDTH, GATOMON_IDLE_1_HEIGHT, Gatomon_Idle_1_data};
-     SpriteFrame gatomon_walk_0_sf = {GATOMON_WALK_0_WIDTH, GATOMON_WALK_0_HEIGHT, Gatomon_Walk_0_data};
-     SpriteFrame gatomon_walk_1_sf = {GATOMON_WALK_1_WIDTH, GATOMON_WALK_1_HEIGHT, Gatomon_Walk_1_data};
-     SpriteFrame gomamon_idle_0_sf = {GOMAMON_IDLE_0_WIDTH, GOMAMON_IDLE_0_HEIGHT, Gomamon_Idle_0_data};
-     SpriteFrame gomamon_idle_1_sf = {GOMAMON_IDLE_1_WIDTH, GOMAMON_IDLE_1_HEIGHT, Gomamon_Idle_1_data};
-     SpriteFrame gomamon_walk_0_sf = {GOMAMON_WALK_0_WIDTH, GOMAMON_WALK_0_HEIGHT, Gomamon_Walk_0_data};
-     SpriteFrame gomamon_walk_1_sf = {GOMAMON_WALK_1_WIDTH, GOMAMON_WALK_1_HEIGHT, Gomamon_Walk_1_data};
-     SpriteFrame palmon_idle_0_sf = {PALMON_IDLE_0_WIDTH, PALMON_IDLE_0_HEIGHT, Palmon_Idle_0_data};
-     SpriteFrame palmon_idle_1_sf = {PALMON_IDLE_1_WIDTH, PALMON_IDLE_1_HEIGHT, Palmon_Idle_1_data};
-     SpriteFrame palmon_walk_0_sf = {PALMON_WALK_0_WIDTH, PALMON_WALK_0_HEIGHT, Palmon_Walk_0_data};
-     SpriteFrame palmon_walk_1_sf = {PALMON_WALK_1_WIDTH, PALMON_WALK_1_HEIGHT, Palmon_Walk_1_data};
-     SpriteFrame tentomon_idle_0_sf = {TENTOMON_IDLE_0_WIDTH, TENTOMON_IDLE_0_HEIGHT, Tentomon_Idle_0_data};
-     SpriteFrame tentomon_idle_1_sf = {TENTOMON_IDLE_1_WIDTH, TENTOMON_IDLE_1_HEIGHT, Tentomon_Idle_1_data};
-     SpriteFrame tentomon_walk_0_sf = {TENTOMON_WALK_0_WIDTH, TENTOMON_WALK_0_HEIGHT, Tentomon_Walk_0_data};
-     SpriteFrame tentomon_walk_1_sf = {TENTOMON_WALK_1_WIDTH, TENTOMON_WALK_1_HEIGHT, Tentomon_Walk_1_data};
-     SpriteFrame patamon_idle_0_sf = {PATAMON_IDLE_0_WIDTH, PATAMON_IDLE_0_HEIGHT, Patamon_Idle_0_data};
-     SpriteFrame patamon_idle_1_sf = {PATAMON_IDLE_1_WIDTH, PATAMON_IDLE_1_HEIGHT, Patamon_Idle_1_data};
-     SpriteFrame patamon_walk_0_sf = {PATAMON_WALK_0_WIDTH, PATAMON_WALK_0_HEIGHT, Patamon_Walk_0_data};
-     SpriteFrame patamon_walk_1_sf = {PATAMON_WALK_1_WIDTH, PATAMON_WALK_1_HEIGHT, Patamon_Walk_1_data};
-
-    agumon_idle_anim.addFrame(agumon_idle_0_sf, 1000); agumon_idle_anim.addFrame(agumon_idle_1_sf, 1000); agumon_idle_anim.loops = true;
-    agumon_walk_anim.addFrame(agumon_walk_0_sf, 300); agumon_walk_anim.addFrame(agumon_walk_1_sf, 300); agumon_walk_anim.addFrame(agumon_walk_0_sf, 300); agumon_walk_anim.addFrame(agumon_walk_1_sf, 300); agumon_walk_anim.loops = false;
-    gabumon_idle_anim.addFrame(gabumon_idle_0_sf, 1100); gabumon_idle_anim.addFrame(gabumon_idle_1_sf, 1100); gabumon_idle_anim.loops = true;
-    gabumon_walk_anim.addFrame(gabumon_walk_0_sf, 320); gabumon_walk_anim.addFrame(gabumon_walk_1_sf, 320); gabumon_walk_anim.addFrame(gabumon_walk_0_sf, 320); gabumon_walk_anim.addFrame(gabumon_walk_1_sf, 320); gabumon_walk_anim.loops = false;
-    biyomon_idle_anim.addFrame(biyomon_idle_0_sf, 960); biyomon_idle_anim.addFrame(biyomon_idle_1_sf, 960); biyomon_idle_anim.loops = true;
-    biyomon_walk_anim.addFrame(biyomon_walk_0_sf, 280); biyomon_walk_anim.addFrame(biyomon_walk_1_sf, 280); biyomon_walk_anim.addFrame(biyomon_walk_0_sf, 280); biyomon_walk_anim.addFrame(biyomon_walk_1_sf, 280); biyomon_walk_anim.loops = false;
-    gatomon_idle_anim.addFrame(gatomon_idle_0_sf, 1200); gatomon_idle_anim.addFrame(gatomon_idle_1_sf, 1200); gatomon_idle_anim.loops = true;
-    gatomon_walk_anim.addFrame(gatomon_walk_0_sf, 340); gatomon_walk_anim.addFrame(gatomon_walk_1_sf, 340); gatomon_walk_anim.addFrame(gatomon_walk_0_sf, 340); gatomon_walk_anim.addFrame(gatomon_walk_1_sf, 340); gatomon_walk_anim.loops = false;
-    gomamon_idle_anim.addFrame(gomamon_idle_0_sf, 1040); gomamon_idle_anim.addFrame(gomamon_idle_1_sf, 1040); gomamon_idle_anim.loops = true;
-    gomamon_walk_anim.addFrame(gomamon_walk_0_sf, 310); gomamon_walk_anim.addFrame(gomamon_walk_1_sf, 310); gomamon_walk_anim.addFrame(gomamon_walk_0_sf, 310); gomamon_walk_anim.addFrame(gomamon_walk_1_sf, 310); gomamon_walk_anim.loops = false;
-    palmon_idle_anim.addFrame(palmon_idle_0_sf, 1080); palmon_idle_anim.addFrame(palmon_idle_1_sf, 1080); palmon_idle_anim.loops = true;
-    palmon_walk_anim.addFrame(palmon_walk_0_sf, 330); palmon_walk_anim.addFrame(palmon_walk_1_sf, 330); palmon_walk_anim.addFrame(palmon_walk_0_sf, 330); palmon_walk_anim.addFrame(palmon_walk_1_sf, 330); palmon_walk_anim.loops = false;
-    tentomon_idle_anim.addFrame(tentomon_idle_0_sf, 920); tentomon_idle_anim.addFrame(tentomon_idle_1_sf, 920); tentomon_idle_anim.loops = true;
-    tentomon_walk_anim.addFrame(tentomon_walk_0_sf, 290); tentomon_walk_anim.addFrame(tentomon_walk_1_sf, 290); tentomon_walk_anim.addFrame(tentomon_walk_0_sf, 290); tentomon_walk_anim.addFrame(tentomon_walk_1_sf, 290); tentomon_walk_anim.loops = false;
-    patamon_idle_anim.addFrame(patamon_idle_0_sf, 1060); patamon_idle_anim.addFrame(patamon_idle_1_sf, 1060); patamon_idle_anim.loops = true;
-    patamon_walk_anim.addFrame(patamon_walk_0_sf, 300); patamon_walk_anim.addFrame(patamon_walk_1_sf, 300); patamon_walk_anim.addFrame(patamon_walk_0_sf, 300); patamon_walk_anim.addFrame(patamon_walk_1_sf, 300); patamon_walk_anim.loops = false;
-
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Digimon animations setup complete.");
-}
-
 // --- Helper: Select Correct Animation Based on State/Digimon ---
-void Game::selectActiveAnimation(bool forceReset) {
-     Animation* previous_anim = active_anim;
-
-     if (current_state == STATE_IDLE) {
-         switch(current_digimon) { // Copied from old main
-            case DIGI_AGUMON:   active_anim = &agumon_idle_anim; break;
-            case DIGI_GABUMON:  active_anim = &gabumon_idle_anim; break;
-            case DIGI_BIYOMON:  active_anim = &biyomon_idle_anim; break;
-            case DIGI_GATOMON:  active_anim = &gatomon_idle_anim; break;
-            case DIGI_GOMAMON:  active_anim = &gomamon_idle_anim; break;
-            case DIGI_PALMON:   active_anim = &palmon_idle_anim; break;
-            case DIGI_TENTOMON: active_anim = &tentomon_idle_anim; break;
-            case DIGI_PATAMON:  active_anim = &patamon_idle_anim; break;
-            default:            active_anim = &agumon_idle_anim;
-         }
-     } else { // STATE_WALKING
-          switch(current_digimon) { // Copied from old main
-            case DIGI_AGUMON:   active_anim = &agumon_walk_anim; break;
-            case DIGI_GABUMON:  active_anim = &gabumon_walk_anim; break;
-            case DIGI_BIYOMON:  active_anim = &biyomon_walk_anim; break;
-            case DIGI_GATOMON:  active_anim = &gatomon_walk_anim; break;
-            case DIGI_GOMAMON:  active_anim = &gomamon_walk_anim; break;
-            case DIGI_PALMON:   active_anim = &palmon_walk_anim; break;
-            case DIGI_TENTOMON: active_anim = &tentomon_walk_anim; break;
-            case DIGI_PATAMON:  active_anim = &patamon_walk_anim; break;
-            default:            active_anim = &agumon_walk_anim;
-         }
-     }
+void Game::selectActiveAnimation(bool forceReset, uint32_t startTime) {
+     AnimAction action = (current_state == STATE_IDLE) ? ACTION_IDLE : ACTION_WALK;
 
      // Reset frame index and timer if the animation changed OR if forced
-     if (forceReset || active_anim != previous_anim) {
+     if (forceReset || action != current_action || active_anim.empty()) {
+         current_action = action;
+         active_anim = animationFor(current_digimon, action, current_assets->frames.data());
          current_anim_frame_idx = 0;
-         // Always reset timer when animation changes/is forced for simplicity here
-         last_anim_update_time = SDL_GetTicks();
+         anim_start_time = startTime; // Frames are sampled relative to this
          SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Animation selected/reset.");
      }
 }
 
+// --- Helper: Start Loading a Selected Digimon ---
+void Game::requestDigimon(DigimonType digimon) {
+    if (digimon == pending_digimon) return;
+    if (pending_digimon != DIGI_COUNT) {
+        assets->unpin(pending_digimon); // Superseded before it finished loading
+        pending_digimon = DIGI_COUNT;
+    }
+    if (digimon == current_digimon) return;
 
-// --- Helper: Draw Background Tile Portion ---
-void Game::drawClippedTile(int dest_x_unclipped, const uint16_t* tile_data,
-                         int layer_tile_width, int layer_tile_height)
-{
-    // This logic is identical to the lambda in your old main.cpp
-    if (!display || !tile_data) return;
+    releaseCrowdAssets(); // Keep the cache within budget while the new Digimon loads
+    pending_digimon = digimon;
+    pinCharacter(digimon);
 
-    int src_x = 0, src_y = 0;
-    int src_w = layer_tile_width, src_h = layer_tile_height;
-    int dest_x = dest_x_unclipped, dest_y = 0;
-    int dest_w = layer_tile_width, dest_h = layer_tile_height;
+    // Predictive prefetch: the neighbours are what SELECT_NEXT / SELECT_PREV load next
+    // (replays load on the spot, see pinCharacter)
+    if (clock.isVirtual()) return;
+    assets->prefetch((digimon + 1) % DIGI_COUNT);
+    assets->prefetch((digimon + DIGI_COUNT - 1) % DIGI_COUNT);
+}
 
-    // Clip Left
-    if (dest_x < 0) {
-        int clip = -dest_x; if (clip >= layer_tile_width) return;
-        src_x += clip; src_w -= clip; dest_w -= clip; dest_x = 0;
+// --- Helper: Pin a Character, Loading It in the Background ---
+// Replays load on the spot instead: when a background load finishes is up to the machine,
+// and the frames showing the old character meanwhile would differ from run to run.
+void Game::pinCharacter(DigimonType digimon) {
+    if (clock.isVirtual()) assets->pinAndLoad(digimon);
+    else assets->pinAsync(digimon);
+}
+
+// --- Helper: Unpin a Character Once No Frame in Flight Draws It ---
+// Frames submitted so far may show it, and a render thread reads the sprites straight from
+// the asset cache, so eviction has to wait until the display is past them. Displays that draw
+// inside submit() are past them already.
+void Game::releaseCharacter(DigimonType digimon) {
+    if (display && display->framesShown(frames_rendered) < frames_rendered) {
+        pending_unpins.push_back({digimon, frames_rendered});
+        return;
     }
-    // Clip Right
-    if (dest_x + dest_w > WINDOW_WIDTH) {
-        int clip = (dest_x + dest_w) - WINDOW_WIDTH; if (clip >= layer_tile_width) return;
-        src_w -= clip; dest_w -= clip;
+    assets->unpin(digimon);
+}
+
+void Game::unpinShownCharacters() {
+    if (pending_unpins.empty()) return;
+    const uint64_t shown = display->framesShown(frames_rendered);
+    size_t kept = 0;
+    for (const PendingUnpin& pending : pending_unpins) {
+        if (shown >= pending.last_frame) assets->unpin(pending.digimon);
+        else pending_unpins[kept++] = pending;
     }
-    // Clip Bottom
-    if (dest_y + dest_h > WINDOW_HEIGHT) {
-         int clip = (dest_y + dest_h) - WINDOW_HEIGHT; if (clip >= layer_tile_height) return;
-         src_h -= clip; dest_h -= clip;
+    pending_unpins.resize(kept);
+}
+
+// --- Helper: Swap to the Pending Digimon Once Resident ---
+void Game::completePendingSwitch() {
+    if (pending_digimon == DIGI_COUNT) return;
+
+    const CharacterAssets* loaded = assets->find(pending_digimon);
+    if (!loaded) return; // Keep showing the current Digimon until it's ready
+
+    releaseCharacter(current_digimon);
+    current_digimon = pending_digimon;
+    current_assets = loaded;
+    pending_digimon = DIGI_COUNT;
+    SDL_Log("Switched character to %s", kDigimonRoster[current_digimon].name);
+    if (select_pressed_at != 0 && input_pressed_at == 0) { // From the press to the first frame showing it
+        input_pressed_at = select_pressed_at;
+        input_frame = 0;
     }
+    select_pressed_at = 0;
 
-    // Draw if visible using the display interface
-    if (dest_w > 0 && src_w > 0 && dest_h > 0 && src_h > 0) {
-        display->drawPixels(dest_x, dest_y, dest_w, dest_h, tile_data,
-                           layer_tile_width, layer_tile_height, src_x, src_y);
+    current_state = STATE_IDLE; // Force idle on switch
+    queued_steps = 0; // Reset steps on switch
+    selectActiveAnimation(true, clock.now());
+    if (crowd_mode) spawnCrowd(clock.now()); // New neighbours join the new current Digimon
+}
+
+// --- Helper: Enter/Leave Crowd Mode ---
+void Game::setCrowdMode(bool enabled, uint32_t currentTime) {
+    if (enabled == crowd_mode) return;
+    crowd_mode = enabled;
+    if (crowd_mode) {
+        spawnCrowd(currentTime);
+    } else {
+        releaseCrowdAssets();
+        crowd.clear();
+    }
+    SDL_Log("Crowd mode %s", crowd_mode ? "on" : "off");
+}
+
+// --- Helper: Populate the Crowd with the Current Digimon and Its Neighbours ---
+void Game::spawnCrowd(uint32_t currentTime) {
+    releaseCrowdAssets();
+    crowd_neighbours[0] = static_cast<DigimonType>((current_digimon + 1) % DIGI_COUNT);
+    crowd_neighbours[1] = static_cast<DigimonType>((current_digimon + DIGI_COUNT - 1) % DIGI_COUNT);
+    // Current + both neighbours is exactly what the cache budget was sized for
+    pinCharacter(crowd_neighbours[0]);
+    pinCharacter(crowd_neighbours[1]);
+    crowd_pinned = true;
+
+    const DigimonType members[3] = {current_digimon, crowd_neighbours[0], crowd_neighbours[1]};
+    const int world_width = WINDOW_WIDTH + 2 * CROWD_SPRITE_MARGIN;
+    const int ground_top = WINDOW_HEIGHT / 2 + 40; // Feet rows, back to front
+    const int ground_depth = WINDOW_HEIGHT - ground_top + 60;
+    uint32_t seed = 0x5EED;
+
+    crowd.clear();
+    crowd.reserve(CROWD_SIZE);
+    for (int i = 0; i < CROWD_SIZE; ++i) {
+        DigimonType digimon = members[i % 3];
+        float x = static_cast<float>(nextCrowdRandom(seed) % world_width);
+        float y = static_cast<float>(ground_top + nextCrowdRandom(seed) % ground_depth);
+        uint32_t start = currentTime - nextCrowdRandom(seed) % 1000; // Desync the clips
+        if (i % 2 == 0) {
+            crowd.create(digimon, ACTION_IDLE, x, y, 0.0f, start);
+        } else {
+            float speed = 0.5f + static_cast<float>(nextCrowdRandom(seed) % 100) / 100.0f;
+            crowd.create(digimon, ACTION_WALK, x, y, speed, start, true);
+        }
     }
-}
\ No newline at end of file
+}
+
+// --- Helper: Drop the Crowd's Pins on the Neighbouring Digimon ---
+void Game::releaseCrowdAssets() {
+    if (!crowd_pinned) return;
+    releaseCharacter(crowd_neighbours[0]);
+    releaseCharacter(crowd_neighbours[1]);
+    crowd_pinned = false;
+}
+
+// --- Helper: Animate, Move and Sort the Crowd ---
+void Game::updateCrowd(uint32_t currentTime, float steps) {
+    crowd.updateAnimations(currentTime);
+    crowd.updateMovement(steps, static_cast<float>(WINDOW_WIDTH + 2 * CROWD_SPRITE_MARGIN));
+
+    // Characters still loading (or released mid-switch) are simply left out this frame
+    const SpriteFrame* sprites[DIGI_COUNT] = {};
+    sprites[current_digimon] = current_assets->frames.data();
+    if (crowd_pinned) {
+        for (DigimonType neighbour : crowd_neighbours) {
+            if (const CharacterAssets* loaded = assets->find(neighbour)) sprites[neighbour] = loaded->frames.data();
+        }
+    }
+    crowd_renderer.prepare(crowd, sprites);
+}
@@ -0,0 +1,149 @@
+#include "InputRecording.h"
+#include <SDL_log.h>
+#include <string.h>
+
+static const char kMagic[4] = {'D', 'G', 'I', 'N'};
+static const uint8_t kVersion = 2;
+static const uint8_t kFirstVersion = 1; // No steps field
+
+static void writeVarint(FILE* file, uint32_t value) {
+    uint8_t bytes[5];
+    int n = 0;
+    do {
+        bytes[n] = value & 0x7F;
+        value >>= 7;
+        if (value) bytes[n] |= 0x80;
+        n++;
+    } while (value);
+    fwrite(bytes, 1, n, file);
+}
+
+static bool readVarint(FILE* file, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        int byte = fgetc(file);
+        if (byte == EOF) return false;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false; // Too long for 32 bits
+}
+
+// --- Loading ---
+bool loadInputRecording(const char* path, InputRecording& recording) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s: cannot open", path);
+        return false;
+    }
+    char magic[4];
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) || memcmp(magic, kMagic, sizeof(magic)) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s: not an input recording", path);
+        fclose(file);
+        return false;
+    }
+    const int version = fgetc(file);
+    const int action_count = fgetc(file);
+    if (version == EOF || action_count == EOF) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s: header cut short", path);
+        fclose(file);
+        return false;
+    }
+    if (version < kFirstVersion || version > kVersion) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s: recording format version %d, this build reads versions %d to %d",
+                     path, version, kFirstVersion, kVersion);
+        fclose(file);
+        return false;
+    }
+    if (action_count != INPUT_ACTION_COUNT) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s: recorded with %d actions, this build has %d", path, action_count,
+                     INPUT_ACTION_COUNT);
+        fclose(file);
+        return false;
+    }
+
+    recording.frames.clear();
+    recording.end_ms = 0;
+    uint32_t time_ms = 0;
+    bool ended = false;
+    while (!ended) {
+        uint32_t delta;
+        InputState state;
+        uint32_t steps;
+        if (!readVarint(file, delta) || !readVarint(file, state.pressed) || !readVarint(file, state.released) ||
+            !readVarint(file, state.held)) {
+            break;
+        }
+        if (version == kFirstVersion) {
+            steps = (state.pressed & actionBit(InputAction::STEP)) ? 1 : 0;
+        } else if (!readVarint(file, steps)) {
+            break;
+        }
+        time_ms += delta;
+        if (state.pressed == 0 && state.released == 0) {
+            recording.end_ms = time_ms;
+            ended = true;
+        } else {
+            recording.frames.push_back({time_ms, state, steps});
+        }
+    }
+    fclose(file);
+    if (!ended) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s: truncated after %zu frames", path, recording.frames.size());
+        return false;
+    }
+    return true;
+}
+
+// --- Recording ---
+InputRecorder::InputRecorder() : file(nullptr), started(false), start_ms(0), last_ms(0), frames(0) {}
+
+InputRecorder::~InputRecorder() {
+    if (file) finish(start_ms + last_ms);
+}
+
+bool InputRecorder::open(const char* path) {
+    if (file) fclose(file);
+    file = fopen(path, "wb");
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s: cannot create", path);
+        return false;
+    }
+    fwrite(kMagic, 1, sizeof(kMagic), file);
+    fputc(kVersion, file);
+    fputc(INPUT_ACTION_COUNT, file);
+    started = false;
+    last_ms = 0;
+    frames = 0;
+    return true;
+}
+
+void InputRecorder::record(uint32_t now_ms, const InputState& state, uint32_t steps) {
+    if (!file) return;
+    if (!started) {
+        started = true;
+        start_ms = now_ms;
+    }
+    if (state.pressed == 0 && state.released == 0) return; // Nothing happened
+    writeEntry(now_ms, state, steps);
+    frames++;
+}
+
+void InputRecorder::finish(uint32_t now_ms) {
+    if (!file) return;
+    if (!started) start_ms = now_ms;
+    writeEntry(now_ms, InputState{0, 0, 0}, 0);
+    fclose(file);
+    file = nullptr;
+}
+
+void InputRecorder::writeEntry(uint32_t now_ms, const InputState& state, uint32_t steps) {
+    uint32_t time_ms = now_ms - start_ms;
+    if (time_ms < last_ms) time_ms = last_ms; // Never backwards
+    writeVarint(file, time_ms - last_ms);
+    writeVarint(file, state.pressed);
+    writeVarint(file, state.released);
+    writeVarint(file, state.held);
+    writeVarint(file, steps);
+    last_ms = time_ms;
+}
@@ -0,0 +1,31 @@
+#include "LatencyStats.h"
+
+#include <algorithm>
+
+LatencyStats::LatencyStats() : samples{}, next(0), held(0), added(0) {}
+
+void LatencyStats::add(double ms) {
+    samples[next] = ms;
+    next = (next + 1) % WINDOW;
+    if (held < WINDOW) held++;
+    added++;
+}
+
+void LatencyStats::reset() {
+    next = held = 0;
+    added = 0;
+}
+
+LatencySummary LatencyStats::summary() const {
+    LatencySummary summary = {held, 0.0, 0.0, 0.0, 0.0};
+    if (held == 0) return summary;
+    double sorted[WINDOW];
+    std::copy(samples, samples + held, sorted);
+    std::sort(sorted, sorted + held);
+    auto rank = [&](double p) { return sorted[std::min(held - 1, static_cast<size_t>(p * held))]; };
+    summary.p50 = rank(0.50);
+    summary.p95 = rank(0.95);
+    summary.p99 = rank(0.99);
+    summary.max = sorted[held - 1];
+    return summary;
+}
@@ -0,0 +1,63 @@
+#include "LayerCache.h"
+
+LayerCache::LayerCache(const uint16_t* art, int width, int height, int period) :
+    art(art),
+    width(width),
+    height(height),
+    period(period > 0 && period < width ? period : width),
+    pixel_format(PixelFormat::COUNT)
+{
+    // Only wrap at 'period' if the art really repeats there; otherwise cache the whole tile
+    for (int y = 0; y < height && this->period < width; ++y) {
+        const uint16_t* row = art + static_cast<size_t>(y) * width;
+        for (int x = this->period; x < width; ++x) {
+            if (row[x] != row[x - this->period]) {
+                this->period = width;
+                break;
+            }
+        }
+    }
+}
+
+int LayerCache::prepare(int x0, int x1, PixelFormat format) {
+    if (format != pixel_format) {
+        pixel_format = format;
+        ring.assign(static_cast<size_t>(period) * height * bytesPerPixel(format), 0);
+        resident.assign(period, 0);
+    }
+    if (x1 <= x0) return 0;
+    if (x1 - x0 > period) x1 = x0 + period; // One period covers every ring column
+
+    // The range covers at most two stretches of the ring: up to its end, then from column 0
+    const int r0 = x0 % period;
+    const int r1 = r0 + (x1 - x0);
+    const int stretches[2][2] = {{r0, r1 < period ? r1 : period}, {0, r1 > period ? r1 - period : 0}};
+
+    // Convert each run of missing columns in one pass over the rows
+    int converted = 0;
+    for (const auto& stretch : stretches) {
+        int r = stretch[0];
+        while (r < stretch[1]) {
+            while (r < stretch[1] && resident[r]) r++;
+            int run_start = r;
+            while (r < stretch[1] && !resident[r]) r++;
+            if (r > run_start) {
+                convert(run_start, r);
+                converted += r - run_start;
+            }
+        }
+    }
+    return converted;
+}
+
+void LayerCache::convert(int ring_x0, int ring_x1) {
+    BlitSurface target = {ring.data(), period, height, period, pixel_format};
+    BlitSource source = {art, width, height, width, PixelFormat::RGB565};
+    blit(target, nullptr, source, ring_x0, 0, {ring_x0, 0, ring_x1 - ring_x0, height}, BLIT_COPY);
+    for (int r = ring_x0; r < ring_x1; ++r) resident[r] = 1;
+}
+
+const void* LayerCache::pixelAt(int x, int y) const {
+    size_t index = static_cast<size_t>(y) * period + x % period;
+    return ring.data() + index * bytesPerPixel(pixel_format);
+}
@@ -0,0 +1,168 @@
+#include "MonoRenderer.h"
+#include "Blitter.h" // COLOR_KEY_RGB565
+#include "platform/DrawList.h"
+
+static inline int maxInt(int a, int b) { return a > b ? a : b; }
+static inline int minInt(int a, int b) { return a < b ? a : b; }
+static inline int floorDiv(int a, int b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+static inline int ceilDiv(int a, int b) { return -floorDiv(-a, b); }
+
+static inline int luminance(uint16_t c) { // 0..255
+    int r = (c >> 11) << 3, g = ((c >> 5) & 0x3F) << 2, b = (c & 0x1F) << 3;
+    return (77 * r + 150 * g + 29 * b) >> 8;
+}
+
+// Bits [lo, hi) of a word
+static inline MonoWord bitsBetween(int lo, int hi) {
+    if (hi - lo >= MONO_WORD_BITS) return ~MonoWord(0);
+    return ((MonoWord(1) << (hi - lo)) - 1) << lo;
+}
+
+// MONO_WORD_BITS bits of a padded plane row starting at bit 'start' (bits outside the row are 0)
+static inline MonoWord fetchBits(const MonoWord* row, int words, int start) {
+    if (start < 0) return start <= -MONO_WORD_BITS ? 0 : fetchBits(row, words, 0) << -start;
+    const int i = start / MONO_WORD_BITS, b = start % MONO_WORD_BITS;
+    if (i >= words - 1) return 0; // Only the spare word left
+    MonoWord bits = row[i] >> b;
+    if (b) bits |= row[i + 1] << (MONO_WORD_BITS - b);
+    return bits;
+}
+
+MonoPlane makeMonoPlane(const uint16_t* pixels, int width, int height, int downscale, bool flip_x) {
+    static const uint8_t kBayer4[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+    const int s = downscale > 0 ? downscale : 1;
+    MonoPlane plane;
+    plane.width = ceilDiv(width, s);
+    plane.height = ceilDiv(height, s);
+    plane.words_per_row = ceilDiv(plane.width, MONO_WORD_BITS) + 1;
+    plane.ink.assign(static_cast<size_t>(plane.words_per_row) * plane.height, 0);
+    plane.mask.assign(plane.ink.size(), 0);
+    plane.opaque = true;
+
+    for (int py = 0; py < plane.height; ++py) {
+        const int y0 = py * s, y1 = minInt(y0 + s, height);
+        MonoWord* ink_row = plane.ink.data() + static_cast<size_t>(py) * plane.words_per_row;
+        MonoWord* mask_row = plane.mask.data() + static_cast<size_t>(py) * plane.words_per_row;
+        for (int block = 0; block < plane.width; ++block) {
+            const int x0 = block * s, x1 = minInt(x0 + s, width);
+            int covered = 0, lum = 0;
+            for (int y = y0; y < y1; ++y) {
+                const uint16_t* row = pixels + static_cast<size_t>(y) * width;
+                for (int x = x0; x < x1; ++x) {
+                    if (row[x] == COLOR_KEY_RGB565) continue;
+                    covered++;
+                    lum += luminance(row[x]);
+                }
+            }
+            if (covered * 2 < (y1 - y0) * (x1 - x0)) {
+                plane.opaque = false;
+                continue;
+            }
+            const int px = flip_x ? plane.width - 1 - block : block;
+            const MonoWord bit = MonoWord(1) << (px % MONO_WORD_BITS);
+            mask_row[px / MONO_WORD_BITS] |= bit;
+            if (lum / covered < kBayer4[py & 3][px & 3] * 16 + 8) ink_row[px / MONO_WORD_BITS] |= bit;
+        }
+    }
+    return plane;
+}
+
+MonoRenderer::MonoRenderer(int scale) :
+    downscale(scale > 0 ? scale : 1),
+    lcd_width(0),
+    lcd_height(0),
+    words_per_row(0),
+    words_written(0)
+{
+}
+
+bool MonoRenderer::init(int logical_width, int logical_height) {
+    if (logical_width <= 0 || logical_height <= 0) return false;
+    lcd_width = ceilDiv(logical_width, downscale);
+    lcd_height = ceilDiv(logical_height, downscale);
+    words_per_row = ceilDiv(lcd_width, MONO_WORD_BITS);
+    framebuffer.assign(static_cast<size_t>(words_per_row) * lcd_height, 0);
+    words_written = 0;
+    return true;
+}
+
+size_t MonoRenderer::planeBytes() const {
+    size_t bytes = 0;
+    for (const auto* cache : {&planes, &mirrored_planes}) {
+        for (const auto& entry : *cache) bytes += (entry.second.ink.size() + entry.second.mask.size()) * sizeof(MonoWord);
+    }
+    return bytes;
+}
+
+void MonoRenderer::forgetSource(const uint16_t* pixels) {
+    for (auto* cache : {&planes, &mirrored_planes}) {
+        for (auto it = cache->begin(); it != cache->end();) {
+            if (it->first.pixels == pixels) it = cache->erase(it);
+            else ++it;
+        }
+    }
+}
+
+const MonoPlane& MonoRenderer::planeFor(const DrawCommand& cmd, bool flip_x) {
+    auto& cache = flip_x ? mirrored_planes : planes;
+    const SourceKey key = {cmd.pixels, cmd.source_width, cmd.source_height};
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+    return cache[key] = makeMonoPlane(cmd.pixels, cmd.source_width, cmd.source_height, downscale, flip_x);
+}
+
+void MonoRenderer::clear(uint16_t color) {
+    const MonoWord fill = luminance(color) < 128 ? ~MonoWord(0) : 0;
+    for (MonoWord& word : framebuffer) word = fill;
+    words_written += framebuffer.size();
+}
+
+void MonoRenderer::drawCommand(const DrawCommand& cmd) {
+    if (framebuffer.empty() || !cmd.pixels) return;
+    const int s = downscale;
+    const bool flip_x = (cmd.flags & DRAW_FLIP_X) != 0;
+    const bool flip_y = (cmd.flags & DRAW_FLIP_Y) != 0;
+    const bool keyed = (cmd.flags & DRAW_COLOR_KEY) && !(cmd.flags & DRAW_OPAQUE);
+
+    // The blit and its clip in LCD dots; rounding outward keeps scrolled tiles from leaving gaps
+    const int bx = floorDiv(cmd.dest_x, s), by = floorDiv(cmd.dest_y, s);
+    const int bw = ceilDiv(cmd.width, s), bh = ceilDiv(cmd.height, s);
+    const int x0 = maxInt(maxInt(bx, floorDiv(cmd.clip.x, s)), 0);
+    const int x1 = minInt(minInt(bx + bw, ceilDiv(cmd.clip.x + cmd.clip.w, s)), lcd_width);
+    const int y0 = maxInt(maxInt(by, floorDiv(cmd.clip.y, s)), 0);
+    const int y1 = minInt(minInt(by + bh, ceilDiv(cmd.clip.y + cmd.clip.h, s)), lcd_height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const MonoPlane& plane = planeFor(cmd, flip_x);
+    const bool masked = keyed && !plane.opaque;
+    const int plane_x = (flip_x ? cmd.source_width - cmd.source_x - cmd.width : cmd.source_x) / s;
+    const int plane_y = cmd.source_y / s;
+    const int first_word = x0 / MONO_WORD_BITS, last_word = (x1 - 1) / MONO_WORD_BITS;
+
+    for (int y = y0; y < y1; ++y) {
+        const int row = plane_y + (flip_y ? bh - 1 - (y - by) : y - by);
+        if (row < 0 || row >= plane.height) continue;
+        const MonoWord* ink_row = plane.ink.data() + static_cast<size_t>(row) * plane.words_per_row;
+        const MonoWord* mask_row = plane.mask.data() + static_cast<size_t>(row) * plane.words_per_row;
+        MonoWord* dst = framebuffer.data() + static_cast<size_t>(y) * words_per_row;
+
+        for (int k = first_word; k <= last_word; ++k) {
+            const int word_x = k * MONO_WORD_BITS;
+            const int start = plane_x + word_x - bx; // Plane column landing on this word's bit 0
+            MonoWord mask = bitsBetween(maxInt(x0 - word_x, 0), minInt(x1 - word_x, MONO_WORD_BITS));
+            if (masked) mask &= fetchBits(mask_row, plane.words_per_row, start);
+            const MonoWord ink = fetchBits(ink_row, plane.words_per_row, start);
+            dst[k] = (dst[k] & ~mask) | (ink & mask);
+        }
+        words_written += last_word - first_word + 1;
+    }
+}
+
+void MonoRenderer::submit(DrawList& list) {
+    // Whole frames every time: at one bit per dot a full redraw costs less than tracking damage
+    list.sortByLayer();
+    list.cullOccluded();
+    if (list.hasClear()) clear(list.clearColor());
+    const DrawCommand* cmd = list.commands();
+    for (size_t i = 0; i < list.size(); ++i, ++cmd) drawCommand(*cmd);
+}
@@ -0,0 +1,192 @@
+#include "ParallaxScene.h"
+#include "Blitter.h" // isOpaque
+#include "platform/DrawList.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+ParallaxScene::ParallaxScene() : sprites_behind(0), clear_color(0x0000), far_layers_hidden(false) {}
+
+bool ParallaxScene::fail(const char* origin, int line, const std::string& message) {
+    last_error = std::string(origin) + ":" + std::to_string(line) + ": " + message;
+    return false;
+}
+
+// Reads a whole raw RGB565 file (little-endian) of exactly width * height pixels
+static bool readRawImage(const std::string& path, int width, int height, std::vector<uint16_t>& pixels) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    std::vector<uint8_t> bytes(static_cast<size_t>(width) * height * 2 + 1);
+    size_t read = std::fread(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+    if (read != bytes.size() - 1) return false; // Too short, or longer than width x height
+    pixels.resize(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<uint16_t>(bytes[2 * i] | (bytes[2 * i + 1] << 8));
+    }
+    return true;
+}
+
+bool ParallaxScene::load(const char* path, const SceneImage* builtin, size_t builtin_count) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        last_error = std::string(path) + ": cannot open";
+        return false;
+    }
+    std::string text;
+    char chunk[4096];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) text.append(chunk, n);
+    std::fclose(file);
+
+    std::string base_dir(path);
+    size_t slash = base_dir.find_last_of("/\\");
+    base_dir = (slash == std::string::npos) ? std::string() : base_dir.substr(0, slash + 1);
+    return parse(text.c_str(), path, base_dir.c_str(), builtin, builtin_count);
+}
+
+bool ParallaxScene::parse(const char* text, const char* origin, const char* base_dir,
+                          const SceneImage* builtin, size_t builtin_count)
+{
+    std::vector<SceneLayer> parsed;
+    std::vector<std::vector<uint16_t>> images_owned;
+    struct FileImage { std::string name; int width, height; }; // Describes images_owned[i]
+    std::vector<FileImage> file_entries;
+    int sprite_z = 0;
+    bool has_sprites = false;
+    uint16_t clear = 0x0000;
+
+    std::istringstream lines(text);
+    std::string raw;
+    int line_no = 0;
+    while (std::getline(lines, raw)) {
+        line_no++;
+        std::istringstream words(raw.substr(0, raw.find('#')));
+        std::string directive;
+        if (!(words >> directive)) continue;
+
+        if (directive == "clear") {
+            std::string value;
+            if (!(words >> value)) return fail(origin, line_no, "expected 'clear <rgb565>'");
+            clear = static_cast<uint16_t>(std::strtoul(value.c_str(), nullptr, 0));
+        } else if (directive == "sprites") {
+            if (!(words >> sprite_z)) return fail(origin, line_no, "expected 'sprites <z>'");
+            has_sprites = true;
+        } else if (directive == "image") {
+            std::string name, file;
+            int width = 0, height = 0;
+            if (!(words >> name >> file >> width >> height) || width <= 0 || height <= 0) {
+                return fail(origin, line_no, "expected 'image <name> <file> <width> <height>'");
+            }
+            images_owned.emplace_back();
+            std::string path = (file[0] == '/') ? file : std::string(base_dir) + file;
+            if (!readRawImage(path, width, height, images_owned.back())) {
+                return fail(origin, line_no, "'" + path + "' is not a " + std::to_string(width) + "x" +
+                                             std::to_string(height) + " RGB565 file");
+            }
+            file_entries.push_back({name, width, height});
+        } else if (directive == "layer") {
+            SceneLayer layer = {};
+            std::string image;
+            if (!(words >> layer.name >> image)) return fail(origin, line_no, "expected 'layer <name> <image> ...'");
+            if (parsed.size() == MAX_LAYERS) return fail(origin, line_no, "too many layers");
+
+            // 'image' art first (the latest definition wins), then the built-ins
+            const uint16_t* pixels = nullptr;
+            for (size_t i = file_entries.size(); i-- > 0 && !pixels;) {
+                if (file_entries[i].name != image) continue;
+                pixels = images_owned[i].data();
+                layer.width = file_entries[i].width;
+                layer.height = file_entries[i].height;
+            }
+            for (size_t i = 0; i < builtin_count && !pixels; ++i) {
+                if (image != builtin[i].name) continue;
+                pixels = builtin[i].pixels;
+                layer.width = builtin[i].width;
+                layer.height = builtin[i].height;
+            }
+            if (!pixels) return fail(origin, line_no, "unknown image '" + image + "'");
+            layer.pixels = pixels;
+            layer.wrap = layer.width;
+
+            std::string key;
+            while (words >> key) {
+                bool ok = true;
+                if (key == "speed") ok = static_cast<bool>(words >> layer.speed);
+                else if (key == "wrap") ok = static_cast<bool>(words >> layer.wrap) && layer.wrap > 0 && layer.wrap <= layer.width;
+                else if (key == "y") ok = static_cast<bool>(words >> layer.y);
+                else if (key == "z") ok = static_cast<bool>(words >> layer.z);
+                else return fail(origin, line_no, "unknown layer property '" + key + "'");
+                if (!ok) return fail(origin, line_no, "bad value for '" + key + "'");
+            }
+            parsed.push_back(layer);
+        } else {
+            return fail(origin, line_no, "unknown directive '" + directive + "'");
+        }
+    }
+    if (parsed.empty()) return fail(origin, line_no, "no layers");
+
+    // Back to front; file order breaks ties
+    std::stable_sort(parsed.begin(), parsed.end(), [](const SceneLayer& a, const SceneLayer& b) { return a.z < b.z; });
+    size_t behind = parsed.size();
+    if (has_sprites) {
+        behind = std::count_if(parsed.begin(), parsed.end(), [&](const SceneLayer& layer) { return layer.z < sprite_z; });
+    }
+    for (SceneLayer& layer : parsed) {
+        layer.flags = isOpaque(layer.pixels, static_cast<long>(layer.width) * layer.height) ? DRAW_OPAQUE : DRAW_COLOR_KEY;
+    }
+
+    std::string name(origin);
+    size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) name = name.substr(slash + 1);
+
+    scene_name = name.substr(0, name.rfind('.'));
+    layers.swap(parsed);
+    file_images.swap(images_owned); // Layers point into these buffers; moving the vectors keeps them
+    drawn_x.assign(layers.size(), INT32_MIN);
+    sprites_behind = behind;
+    clear_color = clear;
+    last_error.clear();
+    return true;
+}
+
+void ParallaxScene::scroll(float frames) {
+    for (SceneLayer& layer : layers) {
+        float wrap = static_cast<float>(layer.wrap);
+        layer.offset = std::fmod(layer.offset - layer.speed * frames, wrap);
+        if (layer.offset < 0.0f) layer.offset += wrap;
+    }
+}
+
+bool ParallaxScene::record(DrawList& list, int viewport_width, int viewport_height) {
+    bool moved = false;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        const SceneLayer& layer = layers[i];
+        // Per-layer culling: nothing is recorded for layers that miss the viewport
+        if (layer.y >= viewport_height || layer.y + layer.height <= 0) continue;
+        if (far_layers_hidden && i + 1 < sprites_behind) continue;
+
+        int first_x = -static_cast<int>(layer.offset);
+        moved = moved || first_x != drawn_x[i];
+        drawn_x[i] = first_x;
+
+        // One period of the art per tile, side by side until the viewport is covered
+        for (int x = first_x; x < viewport_width; x += layer.wrap) {
+            list.blit(drawLayer(i), x, layer.y, layer.wrap, layer.height, layer.pixels,
+                      layer.width, layer.height, 0, 0, layer.flags);
+        }
+    }
+    return moved;
+}
+
+size_t ParallaxScene::maxBlits(int viewport_width) const {
+    size_t blits = 0;
+    for (const SceneLayer& layer : layers) {
+        // The first tile starts up to one period left of the viewport
+        blits += static_cast<size_t>((viewport_width + layer.wrap - 1) / layer.wrap + 1);
+    }
+    return blits;
+}
@@ -0,0 +1,49 @@
+#include "QualityGovernor.h"
+
+const char* qualityLevelName(QualityLevel level) {
+    switch (level) {
+    case QUALITY_FULL: return "full";
+    case QUALITY_NO_FAR_LAYERS: return "no far layers";
+    case QUALITY_HALF_FRAME_RATE: return "half frame rate";
+    case QUALITY_HALF_RESOLUTION: return "half resolution";
+    default: return "?";
+    }
+}
+
+QualityGovernor::QualityGovernor(float high, float low, uint32_t window_frames) :
+    high_load(high),
+    low_load(low),
+    window(window_frames > 0 ? window_frames : 1),
+    current(QUALITY_FULL),
+    frames(0),
+    work_sum(0.0f),
+    interval_sum(0.0f),
+    last_load(0.0f)
+{
+}
+
+bool QualityGovernor::addFrame(float work_ms, float interval_ms) {
+    work_sum += work_ms;
+    interval_sum += interval_ms;
+    // Overruns are acted on after one window; headroom has to last four, so a brief lull
+    // doesn't bring back the level that was just too slow
+    ++frames;
+    if (frames < window) return false;
+    const float load = interval_sum > 0.0f ? work_sum / interval_sum : 0.0f;
+
+    QualityLevel next = current;
+    if (load > high_load) {
+        if (current + 1 < QUALITY_LEVEL_COUNT) next = static_cast<QualityLevel>(current + 1);
+    } else if (frames < 4 * window) {
+        return false; // Keep averaging
+    } else if (load < low_load && current > QUALITY_FULL) {
+        next = static_cast<QualityLevel>(current - 1);
+    }
+
+    frames = 0;
+    work_sum = interval_sum = 0.0f;
+    if (next == current) return false;
+    current = next;
+    last_load = load;
+    return true;
+}
@@ -0,0 +1,126 @@
+#include "RenderThread.h"
+
+#include <chrono>
+
+uint64_t renderClockNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+RenderThread::RenderThread() :
+    sink(nullptr),
+    next_sequence(1),
+    last_drawn(0),
+    submitted_count(0),
+    drawn_count(0),
+    dropped_count(0),
+    stopping(false)
+{
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+bool RenderThread::start(int width, int height, PixelFormat format, FrameSink* frame_sink) {
+    if (width <= 0 || height <= 0) return false;
+    stop();
+    for (int i = 0; i < TripleBuffer<RenderedFrame>::SLOTS; ++i) {
+        RenderedFrame& frame = frames.slot(i);
+        frame.pixels.assign(static_cast<size_t>(width) * height * bytesPerPixel(format), 0);
+        frame.width = width;
+        frame.height = height;
+        frame.format = format;
+    }
+    sink = frame_sink;
+    stopping = false;
+    worker = std::thread(&RenderThread::renderLoop, this);
+    return true;
+}
+
+void RenderThread::stop() {
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work.notify_all();
+    worker.join();
+    sink = nullptr;
+    for (const uint16_t* pixels : forgotten) software.forgetSource(pixels);
+    forgotten.clear();
+}
+
+bool RenderThread::cacheLayer(const uint16_t* art, int width, int height, int period) {
+    if (running()) return true; // The compositor is the render thread's now
+    return software.cacheLayer(art, width, height, period);
+}
+
+void RenderThread::submit(const DrawList& list, bool heat_map, int row_step) {
+    RenderSnapshot& snapshot = snapshots.back();
+    snapshot.list = list; // Same capacity every frame, so this copies without allocating
+    snapshot.heat_map = heat_map;
+    snapshot.row_step = row_step;
+    snapshot.sequence = next_sequence++;
+    snapshot.submitted_ns = renderClockNs();
+    snapshots.publish();
+    submitted_count.fetch_add(1, std::memory_order_relaxed);
+
+    // The lock is only ever held around the render thread's check before it sleeps, never
+    // while it draws; taking it here just keeps that check from missing this snapshot
+    { std::lock_guard<std::mutex> lock(mutex); }
+    work.notify_one();
+}
+
+void RenderThread::forgetSource(const uint16_t* pixels) {
+    if (!running()) {
+        software.forgetSource(pixels);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    forgotten.push_back(pixels);
+}
+
+const RenderedFrame* RenderThread::latestFrame() {
+    return frames.acquire() ? &frames.front() : nullptr;
+}
+
+void RenderThread::renderLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work.wait(lock, [this] { return stopping || snapshots.pending(); });
+            if (stopping) return;
+        }
+        snapshots.acquire();
+        RenderSnapshot& snapshot = snapshots.front();
+        dropped_count.fetch_add(snapshot.sequence - last_drawn - 1, std::memory_order_relaxed);
+        last_drawn = snapshot.sequence;
+        // Taken after the snapshot, so every forgetSource() made before its submit() is in
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            forgetting.swap(forgotten);
+        }
+        for (const uint16_t* pixels : forgetting) software.forgetSource(pixels);
+        forgetting.clear();
+
+        RenderedFrame& frame = frames.back();
+        BlitSurface target = {frame.pixels.data(), frame.width, frame.height, frame.width, frame.format};
+        software.setHeatMap(snapshot.heat_map);
+        software.setRowStep(snapshot.row_step);
+        software.submit(target, snapshot.list); // Whole frame: the damage rect is ignored
+        software.endFrame(0);
+        frame.counters = software.counters();
+        const CompositorStats* stats = software.compositorStats();
+        frame.composited = stats != nullptr;
+        if (stats) frame.stats = *stats;
+        frame.sequence = snapshot.sequence;
+        frame.submitted_ns = snapshot.submitted_ns;
+        frame.finished_ns = renderClockNs();
+
+        if (sink) sink->presentFrame(frame);
+        frames.publish();
+        drawn_count.fetch_add(1, std::memory_order_relaxed);
+        if (sink) sink->frameReady();
+    }
+}
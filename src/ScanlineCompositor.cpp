@@ -0,0 +1,259 @@
+#include "ScanlineCompositor.h"
+#include "platform/DrawList.h"
+
+#include <string.h> // memcpy
+
+static inline int maxInt(int a, int b) { return a > b ? a : b; }
+static inline int minInt(int a, int b) { return a < b ? a : b; }
+
+const ScanlineCompositor::SpanTable& ScanlineCompositor::spansFor(const DrawCommand& cmd) {
+    const SourceKey key = {cmd.pixels, cmd.source_width, cmd.source_height};
+    auto it = span_cache.find(key);
+    if (it != span_cache.end()) return it->second;
+
+    SpanTable& table = span_cache[key];
+    table.row_start.reserve(cmd.source_height + 1);
+    for (int y = 0; y < cmd.source_height; ++y) {
+        table.row_start.push_back(static_cast<uint32_t>(table.spans.size()));
+        const uint16_t* row = cmd.pixels + static_cast<size_t>(y) * cmd.source_width;
+        int x = 0;
+        while (x < cmd.source_width) {
+            while (x < cmd.source_width && row[x] == COLOR_KEY_RGB565) x++;
+            int start = x;
+            while (x < cmd.source_width && row[x] != COLOR_KEY_RGB565) x++;
+            if (x > start) table.spans.push_back({start, x});
+        }
+    }
+    table.row_start.push_back(static_cast<uint32_t>(table.spans.size()));
+    return table;
+}
+
+bool ScanlineCompositor::cacheLayer(const uint16_t* art, int width, int height, int period) {
+    if (!art) return true;
+    LayerCache cache(art, width, height, period);
+    auto inserted = layer_caches.emplace(art, cache);
+    return inserted.second || inserted.first->second.sameLayout(cache);
+}
+
+void ScanlineCompositor::forget(const uint16_t* pixels) {
+    for (auto it = span_cache.begin(); it != span_cache.end();) {
+        if (it->first.pixels == pixels) it = span_cache.erase(it);
+        else ++it;
+    }
+}
+
+template <typename T>
+static size_t vectorBytes(const std::vector<T>& v) { return v.capacity() * sizeof(T); }
+
+size_t ScanlineCompositor::memoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& entry : span_cache) bytes += vectorBytes(entry.second.row_start) + vectorBytes(entry.second.spans);
+    for (const auto& entry : layer_caches) bytes += entry.second.memoryBytes();
+    bytes += vectorBytes(row_first) + vectorBytes(row_cursor) + vectorBytes(by_row) + vectorBytes(active) +
+             vectorBytes(active_next) + vectorBytes(rows) + vectorBytes(columns) + vectorBytes(tables) +
+             vectorBytes(caches) + vectorBytes(uncovered) + vectorBytes(uncovered_next) + vectorBytes(runs);
+    return bytes;
+}
+
+// Counting sort of the commands by first visible row; the stable order keeps draw order per row
+void ScanlineCompositor::bucketByRow(const DrawList& list, int height) {
+    const size_t count = list.size();
+    row_first.assign(height + 1, 0);
+    by_row.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (rows[i].start < rows[i].end) row_first[rows[i].start + 1]++;
+    }
+    for (int y = 0; y < height; ++y) row_first[y + 1] += row_first[y];
+    row_cursor.assign(row_first.begin(), row_first.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        if (rows[i].start < rows[i].end) by_row[row_cursor[rows[i].start]++] = static_cast<uint32_t>(i);
+    }
+}
+
+void ScanlineCompositor::compose(DrawList& list, const BlitSurface& target) {
+    if (!target.pixels) {
+        frame_stats = {};
+        frame_stats.pixels = static_cast<uint64_t>(target.width) * target.height;
+        return;
+    }
+    begin(list, target.width, target.height, target.format);
+    composeRows(list, target, 0);
+}
+
+void ScanlineCompositor::begin(DrawList& list, int width, int height, PixelFormat format) {
+    frame_stats = {};
+    frame_stats.pixels = static_cast<uint64_t>(width) * height;
+    frame_width = width;
+    frame_height = height;
+    next_row = 0;
+    origin_y = list.originY();
+
+    list.sortByLayer(); // Command index order is now draw order
+    frame_stats.blits_culled = static_cast<uint32_t>(list.cullOccluded());
+
+    const size_t count = list.size();
+    rows.resize(count);
+    columns.resize(count);
+    tables.resize(count);
+    caches.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const DrawCommand& cmd = list.commands()[i];
+        BlitRect clip = {cmd.clip.x, cmd.clip.y, cmd.clip.w, cmd.clip.h};
+        BlitClip visible;
+        caches[i] = nullptr;
+        if (clipBlit(width, height, &clip, cmd.source_width, cmd.source_height, cmd.source_x, cmd.source_y,
+                     {cmd.dest_x, cmd.dest_y, cmd.width, cmd.height}, blitFlip(cmd.flags), visible)) {
+            columns[i] = {visible.dest.x, visible.dest.x + visible.dest.w};
+            rows[i] = {visible.dest.y, visible.dest.y + visible.dest.h};
+            // Assets are RGB565 already, so only other targets (and unmirrored reads) use a layer cache
+            auto cached = layer_caches.find(cmd.pixels);
+            if (cached != layer_caches.end() && format != PixelFormat::RGB565 && !(cmd.flags & DRAW_FLIP_X)) {
+                frame_stats.columns_converted +=
+                    cached->second.prepare(visible.source_x, visible.source_x + visible.dest.w, format);
+                caches[i] = &cached->second;
+            }
+        } else {
+            columns[i] = rows[i] = {0, 0}; // Never visible
+        }
+        bool opaque = (cmd.flags & DRAW_OPAQUE) || !(cmd.flags & DRAW_COLOR_KEY);
+        tables[i] = (opaque || rows[i].end <= rows[i].start) ? nullptr : &spansFor(cmd);
+        if (rows[i].start < rows[i].end) {
+            frame_stats.painter_writes += static_cast<uint64_t>(rows[i].end - rows[i].start) * (columns[i].end - columns[i].start);
+        }
+    }
+    bucketByRow(list, height);
+    active.clear();
+}
+
+void ScanlineCompositor::composeRows(const DrawList& list, const BlitSurface& strip, int first_row) {
+    if (first_row != next_row || !strip.pixels) return; // Rows come in order, each once
+    const int last_row = minInt(first_row + strip.height, frame_height);
+    for (int y = first_row; y < last_row; ++y) {
+        // Drop commands that ended above this row, merge in the ones starting on it (both in draw order)
+        active_next.clear();
+        uint32_t* starting = by_row.data() + row_first[y];
+        uint32_t* starting_end = by_row.data() + row_first[y + 1];
+        for (uint32_t index : active) {
+            if (rows[index].end <= y) continue;
+            while (starting != starting_end && *starting < index) active_next.push_back(*starting++);
+            active_next.push_back(index);
+        }
+        while (starting != starting_end) active_next.push_back(*starting++);
+        active.swap(active_next);
+
+        if (row_step > 1 && (origin_y + y) % row_step != 0 && y > first_row) {
+            const size_t pixel_bytes = strip.format == PixelFormat::RGB565 ? sizeof(uint16_t) : sizeof(uint32_t);
+            uint8_t* row = static_cast<uint8_t*>(strip.pixels) + static_cast<size_t>(y - first_row) * strip.stride * pixel_bytes;
+            memcpy(row, row - strip.stride * pixel_bytes, static_cast<size_t>(frame_width) * pixel_bytes);
+            continue;
+        }
+        composeRow(list, strip, y, y - first_row);
+    }
+    next_row = last_row;
+}
+
+// Dest-space opaque runs of 'cmd' on this row within [x0, x1), ascending
+void ScanlineCompositor::buildRuns(const DrawCommand& cmd, const SpanTable* table, int source_row, int x0, int x1) {
+    runs.clear();
+    if (!table) {
+        runs.push_back({x0, x1});
+        return;
+    }
+    const Interval* first = table->spans.data() + table->row_start[source_row];
+    const Interval* last = table->spans.data() + table->row_start[source_row + 1];
+    if (cmd.flags & DRAW_FLIP_X) {
+        // Column c lands at dest_x + source_x + width - 1 - c, so walk the spans backwards
+        int origin = cmd.dest_x + cmd.source_x + cmd.width;
+        for (const Interval* span = last; span != first;) {
+            --span;
+            int a = maxInt(origin - span->end, x0), b = minInt(origin - span->start, x1);
+            if (a < b) runs.push_back({a, b});
+        }
+    } else {
+        int origin = cmd.dest_x - cmd.source_x;
+        for (const Interval* span = first; span != last; ++span) {
+            int a = maxInt(origin + span->start, x0), b = minInt(origin + span->end, x1);
+            if (a < b) runs.push_back({a, b});
+        }
+    }
+}
+
+void ScanlineCompositor::composeRow(const DrawList& list, const BlitSurface& target, int y, int target_row) {
+    uncovered.clear();
+    uncovered.push_back({0, frame_width});
+
+    size_t k = active.size();
+    while (k > 0 && !uncovered.empty()) {
+        const uint32_t index = active[--k];
+        const DrawCommand& cmd = list.commands()[index];
+        const int x0 = columns[index].start, x1 = columns[index].end;
+
+        // Consulted wherever it overlaps still-unresolved pixels
+        int touched = 0;
+        for (const Interval& u : uncovered) touched += maxInt(0, minInt(u.end, x1) - maxInt(u.start, x0));
+        frame_stats.pixels_hidden += (x1 - x0) - touched;
+        if (touched == 0) continue;
+        frame_stats.layers_touched += touched;
+        uint64_t& layer_written = frame_stats.layer_written[renderStatsSlot(cmd.layer)];
+
+        const bool flip_x = (cmd.flags & DRAW_FLIP_X) != 0;
+        int source_row = (cmd.flags & DRAW_FLIP_Y) ? cmd.source_y + cmd.height - 1 - (y - cmd.dest_y)
+                                                   : cmd.source_y + (y - cmd.dest_y);
+        buildRuns(cmd, tables[index], source_row, x0, x1);
+        if (runs.empty()) continue;
+
+        const uint16_t* source_row_pixels = cmd.pixels + static_cast<size_t>(source_row) * cmd.source_width;
+        const LayerCache* cache = caches[index];
+        auto sourceAt = [&](int x) {
+            int column = flip_x ? cmd.source_x + cmd.width - 1 - (x - cmd.dest_x) : cmd.source_x + (x - cmd.dest_x);
+            return source_row_pixels + column;
+        };
+
+        // Write the parts of the runs that are still uncovered; keep the rest uncovered
+        uncovered_next.clear();
+        size_t r = 0;
+        for (const Interval& u : uncovered) {
+            int cursor = u.start;
+            while (r < runs.size() && runs[r].end <= cursor) r++;
+            size_t k2 = r;
+            while (k2 < runs.size() && runs[k2].start < u.end) {
+                int a = maxInt(cursor, runs[k2].start);
+                int b = minInt(u.end, runs[k2].end);
+                if (a > cursor) uncovered_next.push_back({cursor, a});
+                if (b > a) {
+                    if (cache) {
+                        // Straight copy from the ring, split where it wraps
+                        for (int x = a; x < b;) {
+                            int column = cmd.source_x + (x - cmd.dest_x);
+                            int n = minInt(b - x, cache->columnsUntilWrap(column));
+                            blitRun(target, x, target_row, n, cache->pixelAt(column, source_row), cache->format(), false);
+                            x += n;
+                        }
+                    } else {
+                        blitRun(target, a, target_row, b - a, sourceAt(a), PixelFormat::RGB565, flip_x);
+                    }
+                    frame_stats.pixels_written += b - a;
+                    layer_written += b - a;
+                    cursor = b;
+                }
+                if (runs[k2].end <= u.end) k2++; else break;
+            }
+            if (cursor < u.end) uncovered_next.push_back({cursor, u.end});
+            r = k2;
+        }
+        uncovered.swap(uncovered_next);
+    }
+    // Row covered: whatever is left lies wholly behind it
+    while (k > 0) {
+        const uint32_t index = active[--k];
+        frame_stats.pixels_hidden += columns[index].end - columns[index].start;
+    }
+
+    // Whatever no blit covered gets the clear colour (and nothing else writes it)
+    if (list.hasClear()) {
+        for (const Interval& u : uncovered) {
+            fillRect(target, {u.start, target_row, u.end - u.start, 1}, list.clearColor());
+            frame_stats.pixels_cleared += u.end - u.start;
+        }
+    }
+}
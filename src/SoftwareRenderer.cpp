@@ -0,0 +1,124 @@
+#include "SoftwareRenderer.h"
+#include "platform/DrawList.h"
+
+// Heat-map ramp by store count (index 0 = never stored), blended 50% over the frame
+static const uint16_t kHeatRamp[] = {
+    0x0000, // 0: black
+    0x001F, // 1: blue
+    0x07E0, // 2: green
+    0xFFE0, // 3: yellow
+    0xFC00, // 4: orange
+    0xF800, // 5+: red
+};
+static const int HEAT_RAMP_LAST = sizeof(kHeatRamp) / sizeof(kHeatRamp[0]) - 1;
+
+void countComposited(RenderCounters& counters, const CompositorStats& stats, const DrawList& list) {
+    for (int slot = 0; slot < RENDER_STATS_LAYERS; ++slot) {
+        // Each stored pixel was read exactly once; hidden pixels were never fetched
+        counters.pixels_read[slot] += stats.layer_written[slot];
+        counters.pixels_written[slot] += stats.layer_written[slot];
+    }
+    counters.pixels_cleared += stats.pixels_cleared;
+    for (size_t i = 0; i < list.size(); ++i) counters.blits[renderStatsSlot(list.commands()[i].layer)]++;
+}
+
+void SoftwareRenderer::clear(const BlitSurface& target, uint16_t color) {
+    fillRect(target, {0, 0, target.width, target.height}, color);
+    frame.pixels_cleared += static_cast<uint64_t>(target.width) * target.height;
+    if (heat_map) store_counts.assign(static_cast<size_t>(target.width) * target.height, 1);
+}
+
+void SoftwareRenderer::drawCommand(const BlitSurface& target, const DrawCommand& cmd) {
+    int visited = blitDrawCommand(target, cmd);
+    if (visited > 0) countCommand(target, cmd, visited);
+}
+
+void SoftwareRenderer::drawPixels(const BlitSurface& target, int dest_x, int dest_y, int width, int height,
+                                  const uint16_t* pixels, int source_width, int source_height, int source_x, int source_y)
+{
+    BlitSource source = {pixels, source_width, source_height, source_width, PixelFormat::RGB565};
+    int visited = blit(target, nullptr, source, source_x, source_y, {dest_x, dest_y, width, height}, BLIT_KEY);
+    if (visited > 0) {
+        // The kernels don't report how many key pixels they skipped, so stores are an upper bound here
+        frame.blits[0]++;
+        frame.pixels_read[0] += visited;
+        frame.pixels_written[0] += visited;
+    }
+}
+
+// Painter's-algorithm accounting for one executed command. Every visited source pixel is
+// read; stores are exact only in heat-map mode, which walks the source anyway to fill its
+// per-pixel counts (otherwise keyed blits count every visited pixel as stored).
+void SoftwareRenderer::countCommand(const BlitSurface& target, const DrawCommand& cmd, int visited) {
+    const int slot = renderStatsSlot(cmd.layer);
+    frame.blits[slot]++;
+    frame.pixels_read[slot] += visited;
+
+    const bool keyed = (cmd.flags & DRAW_COLOR_KEY) && !(cmd.flags & DRAW_OPAQUE);
+    if (!heat_map) {
+        frame.pixels_written[slot] += visited;
+        return;
+    }
+
+    store_counts.resize(static_cast<size_t>(target.width) * target.height, 0);
+    BlitRect clip = {cmd.clip.x, cmd.clip.y, cmd.clip.w, cmd.clip.h};
+    BlitClip visible;
+    if (!clipBlit(target.width, target.height, &clip, cmd.source_width, cmd.source_height, cmd.source_x, cmd.source_y,
+                  {cmd.dest_x, cmd.dest_y, cmd.width, cmd.height}, blitFlip(cmd.flags), visible)) {
+        return;
+    }
+    const int step_x = (cmd.flags & DRAW_FLIP_X) ? -1 : 1;
+    const int step_y = (cmd.flags & DRAW_FLIP_Y) ? -1 : 1;
+    uint64_t stored = 0;
+    for (int row = 0; row < visible.dest.h; ++row) {
+        const uint16_t* source = cmd.pixels + static_cast<size_t>(visible.source_y + row * step_y) * cmd.source_width
+                                 + visible.source_x;
+        uint8_t* counts = store_counts.data() + static_cast<size_t>(visible.dest.y + row) * target.width + visible.dest.x;
+        for (int x = 0; x < visible.dest.w; ++x) {
+            if (keyed && source[x * step_x] == COLOR_KEY_RGB565) continue;
+            if (counts[x] < 255) counts[x]++;
+            stored++;
+        }
+    }
+    frame.pixels_written[slot] += stored;
+}
+
+void SoftwareRenderer::submit(const BlitSurface& target, DrawList& list) {
+    if (!heat_map) {
+        compositor.compose(list, target);
+        countComposited(frame, compositor.stats(), list);
+        return;
+    }
+
+    store_counts.assign(static_cast<size_t>(target.width) * target.height, 0);
+    list.sortByLayer();
+    list.cullOccluded();
+    if (list.hasClear()) clear(target, list.clearColor());
+    for (size_t i = 0; i < list.size(); ++i) drawCommand(target, list.commands()[i]);
+    applyHeatMap(target);
+}
+
+void SoftwareRenderer::applyHeatMap(const BlitSurface& target) {
+    const uint8_t* counts = store_counts.data();
+    for (int y = 0; y < target.height; ++y, counts += target.width) {
+        if (target.format == PixelFormat::RGB565) {
+            uint16_t* row = static_cast<uint16_t*>(target.pixels) + static_cast<size_t>(y) * target.stride;
+            for (int x = 0; x < target.width; ++x) {
+                uint16_t tint = kHeatRamp[counts[x] < HEAT_RAMP_LAST ? counts[x] : HEAT_RAMP_LAST];
+                row[x] = static_cast<uint16_t>(((row[x] & 0xF7DE) >> 1) + ((tint & 0xF7DE) >> 1)); // Per-channel average
+            }
+        } else {
+            uint32_t* row = static_cast<uint32_t*>(target.pixels) + static_cast<size_t>(y) * target.stride;
+            for (int x = 0; x < target.width; ++x) {
+                uint32_t tint = rgb565ToArgb8888(kHeatRamp[counts[x] < HEAT_RAMP_LAST ? counts[x] : HEAT_RAMP_LAST]);
+                row[x] = 0xFF000000u | (((row[x] & 0xFEFEFE) >> 1) + ((tint & 0xFEFEFE) >> 1));
+            }
+        }
+    }
+}
+
+void SoftwareRenderer::endFrame(uint64_t bytes_uploaded) {
+    frame.bytes_uploaded += bytes_uploaded;
+    last_frame = frame;
+    frame = {};
+}
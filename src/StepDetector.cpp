@@ -0,0 +1,141 @@
+#include "StepDetector.h"
+#include <math.h>
+
+// floor(sqrt(n)), bit by bit: 16 fixed rounds of shifts, adds and masks. No branches to
+// mispredict (magnitudes wander, so each round's outcome is a coin toss) and no divides.
+static inline uint32_t isqrt(uint32_t n) {
+    uint32_t root = 0;
+    for (uint32_t bit = 1u << 30; bit != 0; bit >>= 2) {
+        const uint32_t trial = root + bit;
+        const uint32_t take = 0u - static_cast<uint32_t>(n >= trial); // All ones if this bit is in the root
+        n -= trial & take;
+        root = (root >> 1) + (bit & take);
+    }
+    return root;
+}
+
+// One-pole low-pass step: state += (input - state) * alpha, alpha in Q16, rounded
+static inline int32_t onePole(int32_t state, int32_t input, int32_t alpha_q16) {
+    return state + static_cast<int32_t>((static_cast<int64_t>(input - state) * alpha_q16 + 32768) >> 16);
+}
+
+// Q16 coefficient of a one-pole filter with time constant 'tau_s' at 'rate_hz'
+static int32_t onePoleAlpha(double tau_s, int rate_hz) {
+    int32_t alpha = static_cast<int32_t>(lround((1.0 - exp(-1.0 / (tau_s * rate_hz))) * 65536.0));
+    return alpha > 0 ? alpha : 1;
+}
+
+StepDetector::StepDetector(int rate_hz) :
+    rate(rate_hz < MIN_RATE_HZ ? MIN_RATE_HZ : rate_hz > MAX_RATE_HZ ? MAX_RATE_HZ : rate_hz)
+{
+    const double kPi = 3.14159265358979323846;
+    gravity_alpha = onePoleAlpha(1.0, rate);              // ~1 s average
+    smooth_alpha = onePoleAlpha(1.0 / (2.0 * kPi * 4.0), rate); // ~4 Hz corner
+    min_step_samples = static_cast<uint32_t>(rate / 4);   // 250 ms
+    max_step_samples = static_cast<uint32_t>(rate * 2);   // 2 s
+    reset();
+}
+
+void StepDetector::reset() {
+    gravity_q8 = 0;
+    smooth1_q8 = smooth2_q8 = 0;
+    primed = false;
+    in_peak = false;
+    peak_q8 = 0;
+    peak_sample = 0;
+    peak_level_q8 = 0;
+    sample_index = 0;
+    last_step_sample = 0;
+    step_count = 0;
+    for (uint32_t& interval : intervals) interval = 0;
+    interval_count = 0;
+    interval_next = 0;
+    current_cadence = 0;
+    reported_cadence = 0;
+    events_dropped = 0;
+}
+
+size_t StepDetector::process(const AccelSample* samples, size_t count, StepEvent* events, size_t max_events) {
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const AccelSample& s = samples[i];
+        const int32_t x = s.x, y = s.y, z = s.z;
+        const uint32_t squared = static_cast<uint32_t>(x * x) + static_cast<uint32_t>(y * y) + static_cast<uint32_t>(z * z);
+        const int32_t magnitude_q8 = static_cast<int32_t>(isqrt(squared)) << 8;
+
+        if (!primed) { // Start the gravity estimate at the first reading, not at 0 g
+            gravity_q8 = magnitude_q8;
+            primed = true;
+        }
+        gravity_q8 = onePole(gravity_q8, magnitude_q8, gravity_alpha);
+        smooth1_q8 = onePole(smooth1_q8, magnitude_q8 - gravity_q8, smooth_alpha);
+        smooth2_q8 = onePole(smooth2_q8, smooth1_q8, smooth_alpha);
+
+        step(smooth2_q8, events, max_events, written);
+        sample_index++;
+    }
+    return written;
+}
+
+// --- Peak Detection for One Filtered Sample ---
+void StepDetector::step(int32_t signal_q8, StepEvent* events, size_t max_events, size_t& written) {
+    const int32_t floor_q8 = NOISE_FLOOR << 8;
+    const int32_t threshold_q8 = peak_level_q8 / 2 > floor_q8 ? peak_level_q8 / 2 : floor_q8;
+
+    if (!in_peak) {
+        if (signal_q8 > threshold_q8) {
+            in_peak = true;
+            peak_q8 = signal_q8;
+            peak_sample = sample_index;
+        }
+    } else if (signal_q8 > peak_q8) {
+        peak_q8 = signal_q8;
+        peak_sample = sample_index;
+    } else if (signal_q8 < 0) { // The peak is over: a step unless it's the last one's echo
+        in_peak = false;
+        const uint64_t interval = peak_sample - last_step_sample;
+        if (step_count == 0 || interval >= min_step_samples) {
+            if (step_count > 0 && interval <= max_step_samples) {
+                intervals[interval_next] = static_cast<uint32_t>(interval);
+                interval_next = (interval_next + 1) % INTERVAL_HISTORY;
+                if (interval_count < INTERVAL_HISTORY) interval_count++;
+                uint32_t sum = 0;
+                for (int i = 0; i < interval_count; ++i) sum += intervals[i];
+                current_cadence = static_cast<uint16_t>((60u * rate * interval_count + sum / 2) / sum);
+            }
+            peak_level_q8 = peak_level_q8 == 0 ? peak_q8 : peak_level_q8 + (peak_q8 - peak_level_q8) / 4;
+            last_step_sample = peak_sample;
+            step_count++;
+            emit(STEP_EVENT_STEP, peak_sample, events, max_events, written);
+
+            const uint16_t moved = current_cadence > reported_cadence ? current_cadence - reported_cadence
+                                                                      : reported_cadence - current_cadence;
+            if (current_cadence != 0 && (reported_cadence == 0 || moved >= CADENCE_EVENT_DELTA)) {
+                reported_cadence = current_cadence;
+                emit(STEP_EVENT_CADENCE, sample_index, events, max_events, written);
+            }
+        }
+    }
+
+    // Stopped walking: forget the rhythm and how hard the steps were
+    if (step_count > 0 && !in_peak && sample_index - last_step_sample > max_step_samples && peak_level_q8 != 0) {
+        peak_level_q8 = 0;
+        interval_count = interval_next = 0;
+        current_cadence = 0;
+        if (reported_cadence != 0) {
+            reported_cadence = 0;
+            emit(STEP_EVENT_CADENCE, sample_index, events, max_events, written);
+        }
+    }
+}
+
+void StepDetector::emit(StepEventType type, uint64_t at_sample, StepEvent* events, size_t max_events, size_t& written) {
+    if (written >= max_events) {
+        events_dropped++;
+        return;
+    }
+    StepEvent& e = events[written++];
+    e.type = type;
+    e.cadence = current_cadence;
+    e.time_ms = static_cast<uint32_t>(at_sample * 1000 / rate);
+}
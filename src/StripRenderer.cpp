@@ -0,0 +1,123 @@
+#include "StripRenderer.h"
+
+#include <chrono>
+
+static uint64_t nanosSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+StripRenderer::StripRenderer() :
+    sink(nullptr),
+    max_width(0),
+    strip_height(0),
+    render_next(0),
+    last_stats{},
+    queued_area{},
+    queued{},
+    flush_next(0),
+    stopping(false)
+{
+}
+
+StripRenderer::~StripRenderer() {
+    shutdown();
+}
+
+bool StripRenderer::init(int width, int height, StripSink* strip_sink) {
+    if (width <= 0 || height <= 0 || !strip_sink) return false;
+    shutdown();
+    sink = strip_sink;
+    max_width = width;
+    strip_height = height;
+    for (std::vector<uint16_t>& buffer : buffers) {
+        buffer.assign(static_cast<size_t>(width) * height, 0);
+        buffer.shrink_to_fit(); // Exactly the budget
+    }
+    render_next = flush_next = 0;
+    stopping = false;
+    flusher = std::thread(&StripRenderer::flushLoop, this);
+    return true;
+}
+
+void StripRenderer::shutdown() {
+    if (!flusher.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    flusher.join();
+    for (std::vector<uint16_t>& buffer : buffers) {
+        buffer.clear();
+        buffer.shrink_to_fit();
+    }
+    sink = nullptr;
+}
+
+void StripRenderer::render(DrawList& list, const DrawRect& area) {
+    last_stats = {};
+    if (!flusher.joinable() || area.w <= 0 || area.h <= 0 || area.w > max_width) return;
+
+    auto start = std::chrono::steady_clock::now();
+    compositor.begin(list, area.w, area.h, PixelFormat::RGB565);
+    for (int y = 0; y < area.h; y += strip_height) {
+        const int b = render_next;
+        {
+            // Double buffering: wait for this buffer's previous strip to finish flushing
+            auto wait_start = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this, b] { return !queued[b]; });
+            last_stats.wait_ns += nanosSince(wait_start);
+        }
+
+        const int rows = area.h - y < strip_height ? area.h - y : strip_height;
+        BlitSurface strip = {buffers[b].data(), area.w, rows, area.w, PixelFormat::RGB565};
+        compositor.composeRows(list, strip, y);
+        last_stats.strips++;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queued_area[b] = {area.x, static_cast<int16_t>(area.y + y), area.w, static_cast<int16_t>(rows)};
+            queued[b] = true;
+        }
+        changed.notify_all();
+        render_next = (b + 1) % STRIP_BUFFERS;
+    }
+    last_stats.busy_ns = nanosSince(start) - last_stats.wait_ns;
+}
+
+void StripRenderer::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] {
+        for (bool busy : queued) {
+            if (busy) return false;
+        }
+        return true;
+    });
+}
+
+size_t StripRenderer::memoryBytes() const {
+    size_t bytes = compositor.memoryBytes();
+    for (const std::vector<uint16_t>& buffer : buffers) bytes += buffer.capacity() * sizeof(uint16_t);
+    return bytes;
+}
+
+void StripRenderer::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        // Queued strips are flushed even when stopping, so nothing rendered is lost
+        changed.wait(lock, [this] { return stopping || queued[flush_next]; });
+        if (!queued[flush_next]) return;
+
+        const int b = flush_next;
+        const DrawRect area = queued_area[b];
+        lock.unlock();
+        sink->flushStrip(area, buffers[b].data());
+        lock.lock();
+
+        queued[b] = false;
+        flush_next = (b + 1) % STRIP_BUFFERS;
+        changed.notify_all();
+    }
+}
@@ -1,10 +1,55 @@
 #include "Game.h" // Include the main Game class header
+#include "StepDetector.h" // Accelerometer rate limits
 #include <SDL_log.h> // For logging start/end
 #include <exception> // For exception handling
+#include <cstring> // strcmp
+#include <cstdlib> // atoi
 
-int main(int /*argc*/, char* /*argv*/[]) { // Mark args as unused if needed
+int main(int argc, char* argv[]) {
     SDL_Log("--- Application Entry Point ---");
-    Game digiviceGame; // Create the Game object on the stack
+    // Usage: DigiviceSim [--mono] [--render-thread] [--bindings file] [--record file]
+    //                    [--replay file [--headless]] [--accel file.csv|synthetic [--accel-rate hz]]
+    //                    [scene files...]
+    GameOptions options;
+    const char* bindings_path = nullptr;
+    std::vector<std::string> scene_paths;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--mono") == 0) options.monochrome = true;
+        else if (std::strcmp(argv[i], "--render-thread") == 0) options.render_thread = true;
+        else if (std::strcmp(argv[i], "--bindings") == 0 && i + 1 < argc) bindings_path = argv[++i];
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) options.record_path = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) options.replay_path = argv[++i];
+        else if (std::strcmp(argv[i], "--headless") == 0) options.headless = true;
+        else if (std::strcmp(argv[i], "--accel") == 0 && i + 1 < argc) options.accel_path = argv[++i];
+        else if (std::strcmp(argv[i], "--accel-rate") == 0 && i + 1 < argc) {
+            options.accel_rate_hz = std::atoi(argv[++i]);
+            if (options.accel_rate_hz < StepDetector::MIN_RATE_HZ || options.accel_rate_hz > StepDetector::MAX_RATE_HZ) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--accel-rate %s: the step detector takes %d to %d Hz", argv[i],
+                             StepDetector::MIN_RATE_HZ, StepDetector::MAX_RATE_HZ);
+                return 1;
+            }
+        }
+        else scene_paths.push_back(argv[i]);
+    }
+#ifdef DIGIVICE_STATIC_PLATFORM
+    // This build has only the PC window and keyboard (see include/platform/Platform.h)
+    const char* unsupported = !options.replay_path.empty() ? "--replay"
+                            : options.headless             ? "--headless"
+                            : !options.accel_path.empty()  ? "--accel"
+                            : options.monochrome           ? "--mono"
+                                                           : nullptr;
+    if (unsupported) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s needs the IDisplay/IInput build; this one has DIGIVICE_STATIC_PLATFORM",
+                     unsupported);
+        return 1;
+    }
+#endif
+
+    Game digiviceGame(options); // Create the Game object on the stack
+    if (!scene_paths.empty()) { // Scene files on the command line replace the default ones
+        digiviceGame.setScenePaths(scene_paths);
+    }
+    if (bindings_path) digiviceGame.setBindingsPath(bindings_path);
 
     try {
         if (digiviceGame.initialize()) { // Initialize systems
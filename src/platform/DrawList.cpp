@@ -0,0 +1,173 @@
+#include "platform/DrawList.h"
+#include "Blitter.h"
+
+static const DrawRect kNoClip = {0, 0, INT16_MAX, INT16_MAX};
+
+DrawList::DrawList(size_t capacity) :
+    storage(capacity),
+    scratch(capacity),
+    opaque_indices(capacity),
+    count(0),
+    dropped(0),
+    current_clip(kNoClip),
+    has_clear(false),
+    clear_color(0),
+    has_damage(false),
+    damage_rect(kNoClip),
+    origin_y(0)
+{
+}
+
+void DrawList::reset() {
+    count = 0;
+    dropped = 0;
+    current_clip = kNoClip;
+    has_clear = false;
+    has_damage = false;
+    origin_y = 0;
+}
+
+void DrawList::clear(uint16_t color) {
+    has_clear = true;
+    clear_color = color;
+}
+
+void DrawList::setClip(int x, int y, int width, int height) {
+    current_clip = {static_cast<int16_t>(x), static_cast<int16_t>(y),
+                    static_cast<int16_t>(width), static_cast<int16_t>(height)};
+}
+
+void DrawList::resetClip() {
+    current_clip = kNoClip;
+}
+
+void DrawList::setDamage(int x, int y, int width, int height) {
+    has_damage = true;
+    damage_rect = {static_cast<int16_t>(x), static_cast<int16_t>(y),
+                   static_cast<int16_t>(width > 0 ? width : 0), static_cast<int16_t>(height > 0 ? height : 0)};
+}
+
+DrawRect DrawList::damageWithin(int width, int height, int row_step) const {
+    if (!has_damage) return {0, 0, static_cast<int16_t>(width), static_cast<int16_t>(height)};
+    int x0 = damage_rect.x > 0 ? damage_rect.x : 0;
+    int y0 = damage_rect.y > 0 ? damage_rect.y : 0;
+    int x1 = damage_rect.x + damage_rect.w < width ? damage_rect.x + damage_rect.w : width;
+    int y1 = damage_rect.y + damage_rect.h < height ? damage_rect.y + damage_rect.h : height;
+    if (x1 <= x0 || y1 <= y0) return {0, 0, 0, 0};
+    if (row_step > 1) {
+        y0 -= y0 % row_step;
+        y1 += (row_step - y1 % row_step) % row_step;
+        if (y1 > height) y1 = height;
+    }
+    return {static_cast<int16_t>(x0), static_cast<int16_t>(y0), static_cast<int16_t>(x1 - x0), static_cast<int16_t>(y1 - y0)};
+}
+
+void DrawList::cropTo(const DrawRect& rect) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        DrawCommand cmd = storage[i];
+        int x0 = cmd.clip.x > rect.x ? cmd.clip.x : rect.x;
+        int y0 = cmd.clip.y > rect.y ? cmd.clip.y : rect.y;
+        int x1 = cmd.clip.x + cmd.clip.w < rect.x + rect.w ? cmd.clip.x + cmd.clip.w : rect.x + rect.w;
+        int y1 = cmd.clip.y + cmd.clip.h < rect.y + rect.h ? cmd.clip.y + cmd.clip.h : rect.y + rect.h;
+        if (x1 <= x0 || y1 <= y0) continue;
+        cmd.clip = {static_cast<int16_t>(x0 - rect.x), static_cast<int16_t>(y0 - rect.y),
+                    static_cast<int16_t>(x1 - x0), static_cast<int16_t>(y1 - y0)};
+        cmd.dest_x = static_cast<int16_t>(cmd.dest_x - rect.x);
+        cmd.dest_y = static_cast<int16_t>(cmd.dest_y - rect.y);
+        storage[kept++] = cmd;
+    }
+    count = kept;
+    origin_y += rect.y;
+    has_damage = false; // The cropped target is all damage
+}
+
+bool DrawList::blit(uint8_t layer, int dest_x, int dest_y, int width, int height,
+                    const uint16_t* pixels, int source_width, int source_height,
+                    int source_x, int source_y, uint8_t flags)
+{
+    if (!pixels) return true;
+
+    // Fold the blit's own rect into its clip so backends only deal with one rectangle
+    int x0 = dest_x > current_clip.x ? dest_x : current_clip.x;
+    int y0 = dest_y > current_clip.y ? dest_y : current_clip.y;
+    int x1 = dest_x + width;
+    int y1 = dest_y + height;
+    int clip_x1 = current_clip.x + current_clip.w;
+    int clip_y1 = current_clip.y + current_clip.h;
+    if (x1 > clip_x1) x1 = clip_x1;
+    if (y1 > clip_y1) y1 = clip_y1;
+    if (x1 <= x0 || y1 <= y0) return true; // Nothing visible
+
+    if (count == storage.size()) {
+        dropped++; // Reported by the owner via droppedCount()
+        return false;
+    }
+
+    DrawCommand& cmd = storage[count];
+    cmd.pixels = pixels;
+    cmd.source_width = static_cast<int16_t>(source_width);
+    cmd.source_height = static_cast<int16_t>(source_height);
+    cmd.source_x = static_cast<int16_t>(source_x);
+    cmd.source_y = static_cast<int16_t>(source_y);
+    cmd.dest_x = static_cast<int16_t>(dest_x);
+    cmd.dest_y = static_cast<int16_t>(dest_y);
+    cmd.width = static_cast<int16_t>(width);
+    cmd.height = static_cast<int16_t>(height);
+    cmd.clip = {static_cast<int16_t>(x0), static_cast<int16_t>(y0),
+                static_cast<int16_t>(x1 - x0), static_cast<int16_t>(y1 - y0)};
+    cmd.layer = layer;
+    cmd.flags = flags;
+    cmd.sequence = static_cast<uint16_t>(count);
+    count++;
+    return true;
+}
+
+void DrawList::sortByLayer() {
+    size_t histogram[256] = {};
+    for (size_t i = 0; i < count; ++i) histogram[storage[i].layer]++;
+
+    size_t offset = 0;
+    for (int layer = 0; layer < 256; ++layer) {
+        size_t n = histogram[layer];
+        histogram[layer] = offset;
+        offset += n;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        scratch[histogram[storage[i].layer]++] = storage[i];
+    }
+    storage.swap(scratch);
+}
+
+// Expects draw order (call after sortByLayer). O(n * opaque commands); frames hold few opaque blits.
+size_t DrawList::cullOccluded() {
+    size_t opaque_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (storage[i].flags & DRAW_OPAQUE) opaque_indices[opaque_count++] = static_cast<uint32_t>(i);
+    }
+    if (opaque_count == 0) return 0;
+
+    size_t kept = 0;
+    size_t first_above = 0; // First opaque command after i
+    for (size_t i = 0; i < count; ++i) {
+        while (first_above < opaque_count && opaque_indices[first_above] <= i) first_above++;
+        const DrawRect& r = storage[i].clip;
+        bool hidden = false;
+        for (size_t j = first_above; j < opaque_count && !hidden; ++j) {
+            const DrawRect& o = storage[opaque_indices[j]].clip; // Index > i >= kept: not yet overwritten
+            hidden = o.x <= r.x && o.y <= r.y && o.x + o.w >= r.x + r.w && o.y + o.h >= r.y + r.h;
+        }
+        if (!hidden) storage[kept++] = storage[i];
+    }
+    size_t culled = count - kept;
+    count = kept;
+    return culled;
+}
+
+int blitDrawCommand(const BlitSurface& target, const DrawCommand& cmd) {
+    BlitSource source = {cmd.pixels, cmd.source_width, cmd.source_height, cmd.source_width, PixelFormat::RGB565};
+    BlitRect clip = {cmd.clip.x, cmd.clip.y, cmd.clip.w, cmd.clip.h};
+    BlitRect dest = {cmd.dest_x, cmd.dest_y, cmd.width, cmd.height};
+    BlitMode mode = (cmd.flags & DRAW_OPAQUE) ? BLIT_COPY : ((cmd.flags & DRAW_COLOR_KEY) ? BLIT_KEY : BLIT_COPY);
+    return blit(target, &clip, source, cmd.source_x, cmd.source_y, dest, mode, blitFlip(cmd.flags));
+}
@@ -0,0 +1,14 @@
+#include "platform/IDisplay.h"
+#include "platform/DrawList.h"
+
+void IDisplay::submit(DrawList& list) {
+    replayDrawList(*this, list); // Virtual drawCommand per command; final backends override this
+}
+
+void IDisplay::drawCommand(const DrawCommand& cmd) {
+    // The clip rect is the visible part of the blit; shift the source window to match
+    int source_x = cmd.source_x + (cmd.clip.x - cmd.dest_x);
+    int source_y = cmd.source_y + (cmd.clip.y - cmd.dest_y);
+    drawPixels(cmd.clip.x, cmd.clip.y, cmd.clip.w, cmd.clip.h, cmd.pixels,
+               cmd.source_width, cmd.source_height, source_x, source_y);
+}
@@ -0,0 +1,19 @@
+#include "platform/IInput.h"
+
+#include <string.h>
+
+static const char* const kActionNames[INPUT_ACTION_COUNT] = {
+    "quit", "step", "select_next", "select_prev", "crowd", "heatmap", "next_scene",
+};
+
+const char* inputActionName(InputAction action) {
+    int i = static_cast<int>(action);
+    return (i >= 0 && i < INPUT_ACTION_COUNT) ? kActionNames[i] : "unknown";
+}
+
+InputAction inputActionFromName(const char* name) {
+    for (int i = 0; i < INPUT_ACTION_COUNT; ++i) {
+        if (strcmp(name, kActionNames[i]) == 0) return static_cast<InputAction>(i);
+    }
+    return InputAction::UNKNOWN;
+}
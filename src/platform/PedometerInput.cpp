@@ -0,0 +1,58 @@
+#include "platform/PedometerInput.h"
+#include <SDL_log.h>
+
+PedometerInput::PedometerInput(IInput* key_input, AccelSource* accel, GameClock& game_clock) :
+    keys(key_input),
+    source(accel),
+    clock(game_clock),
+    detector(accel->rateHz()),
+    state{0, 0, 0},
+    steps_pressed(0),
+    started(false),
+    source_ended(false),
+    start_ms(0),
+    samples_read(0)
+{
+    SDL_Log("Pedometer: %d Hz accelerometer", detector.rateHz());
+}
+
+void PedometerInput::update() {
+    keys->update();
+    state = keys->actions();
+    steps_pressed = keys->stepsPressed(); // The key still steps too
+    if (!started) {
+        started = true;
+        start_ms = clock.now();
+    }
+
+    // Everything the sensor has measured since the last update, a batch at a time
+    const uint64_t due = static_cast<uint64_t>(clock.now() - start_ms) * source->rateHz() / 1000;
+    while (!source_ended && samples_read < due) {
+        const uint64_t left = due - samples_read;
+        const size_t got = source->read(batch, left < BATCH ? static_cast<size_t>(left) : BATCH);
+        if (got == 0) {
+            source_ended = true;
+            SDL_Log("Pedometer: accelerometer samples ran out after %u steps", detector.steps());
+            break;
+        }
+        samples_read += got;
+        const size_t count = detector.process(batch, got, events, MAX_EVENTS);
+        for (size_t i = 0; i < count; ++i) {
+            if (events[i].type == STEP_EVENT_STEP) {
+                state.pressed |= actionBit(InputAction::STEP);
+                steps_pressed++;
+            } else {
+                SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Cadence: %u steps/min", events[i].cadence);
+            }
+        }
+    }
+}
+
+bool PedometerInput::waitForInput(uint32_t timeout_ms) {
+    if (started && !source_ended) {
+        const uint32_t elapsed = clock.now() - start_ms;
+        const uint32_t until_batch = WAKE_MS - elapsed % WAKE_MS;
+        if (until_batch < timeout_ms) timeout_ms = until_batch;
+    }
+    return keys->waitForInput(timeout_ms);
+}
@@ -0,0 +1,67 @@
+#include "platform/headless/HeadlessDisplay.h"
+#include "platform/DrawList.h"
+#include "Blitter.h"
+
+HeadlessDisplay::HeadlessDisplay() : screenWidth(0), screenHeight(0), presentedFrames(0) {}
+
+bool HeadlessDisplay::init(const char* /*title*/, int windowWidth, int windowHeight) {
+    if (windowWidth <= 0 || windowHeight <= 0) return false;
+    screenWidth = windowWidth;
+    screenHeight = windowHeight;
+    framebuffer.assign(static_cast<size_t>(screenWidth) * screenHeight, 0xFF000000);
+    presentedFrames = 0;
+    return true;
+}
+
+void HeadlessDisplay::close() {
+    framebuffer.clear();
+    framebuffer.shrink_to_fit();
+}
+
+BlitSurface HeadlessDisplay::surface() {
+    return {framebuffer.data(), screenWidth, screenHeight, screenWidth, PixelFormat::ARGB8888};
+}
+
+BlitSurface HeadlessDisplay::surface(const DrawRect& rect) {
+    return {framebuffer.data() + static_cast<size_t>(rect.y) * screenWidth + rect.x, rect.w, rect.h, screenWidth,
+            PixelFormat::ARGB8888};
+}
+
+void HeadlessDisplay::clear(uint16_t color) {
+    if (framebuffer.empty()) return;
+    renderer.clear(surface(), color);
+}
+
+void HeadlessDisplay::drawPixels(int destX, int destY, int width, int height,
+                                 const uint16_t* pixelData,
+                                 int sourceBufferWidth, int sourceBufferHeight,
+                                 int sourceX, int sourceY)
+{
+    if (!pixelData || framebuffer.empty()) return;
+    renderer.drawPixels(surface(), destX, destY, width, height, pixelData,
+                        sourceBufferWidth, sourceBufferHeight, sourceX, sourceY);
+}
+
+void HeadlessDisplay::drawCommand(const DrawCommand& cmd) {
+    if (framebuffer.empty()) return;
+    renderer.drawCommand(surface(), cmd);
+}
+
+void HeadlessDisplay::present() {
+    presentedFrames++;
+    renderer.endFrame(0); // Nothing leaves memory
+}
+
+uint32_t HeadlessDisplay::frameHash() const {
+    uint32_t hash = 2166136261u;
+    for (uint32_t pixel : framebuffer) hash = (hash ^ pixel) * 16777619u;
+    return hash;
+}
+
+void HeadlessDisplay::submit(DrawList& list) {
+    // Redraw only the damaged region; the framebuffer keeps the rest of the last frame
+    DrawRect damage = list.damageWithin(screenWidth, screenHeight);
+    if (framebuffer.empty() || damage.w == 0) return;
+    list.cropTo(damage);
+    renderer.submit(surface(damage), list);
+}
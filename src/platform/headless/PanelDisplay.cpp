@@ -0,0 +1,184 @@
+#include "platform/headless/PanelDisplay.h"
+#include "platform/DrawList.h"
+#include "SoftwareRenderer.h" // countComposited
+
+const char* flushStrategyName(FlushStrategy strategy) {
+    switch (strategy) {
+        case FlushStrategy::FULL_FRAME: return "full frame";
+        case FlushStrategy::DAMAGE_ROWS: return "damage rows";
+        case FlushStrategy::DAMAGE_RECT: return "damage rect";
+    }
+    return "?";
+}
+
+PanelDisplay::PanelDisplay(const SpiBusConfig& bus, FlushStrategy strategy, int strip_rows) :
+    bus_config(bus),
+    flush_strategy(strategy),
+    strip_height(strip_rows),
+    screenWidth(0),
+    screenHeight(0),
+    frame_area{},
+    window_open(false),
+    dirty_x0(0), dirty_y0(0), dirty_x1(0), dirty_y1(0),
+    estimates{},
+    frames_submitted(0),
+    at_frame_start{},
+    frame{},
+    last_frame{}
+{
+}
+
+PanelDisplay::~PanelDisplay() {
+    close();
+}
+
+bool PanelDisplay::init(const char* /*title*/, int windowWidth, int windowHeight) {
+    if (windowWidth <= 0 || windowHeight <= 0 || bus_config.clock_hz <= 0.0 ||
+        bus_config.command_lanes <= 0 || bus_config.data_lanes <= 0) {
+        return false;
+    }
+    screenWidth = windowWidth;
+    screenHeight = windowHeight;
+    link.reset(new SpiPanel(screenWidth, screenHeight, bus_config));
+    for (PanelTraffic& estimate : estimates) estimate = {};
+    frames_submitted = 0;
+    at_frame_start = {};
+    return strips.init(screenWidth, strip_height < screenHeight ? strip_height : screenHeight, this);
+}
+
+void PanelDisplay::close() {
+    strips.shutdown();
+    link.reset();
+    shadow.clear();
+    shadow.shrink_to_fit();
+}
+
+double PanelDisplay::maxFps(FlushStrategy strategy) const {
+    const PanelTraffic& traffic = estimate(strategy);
+    return traffic.bus_seconds > 0.0 ? frames_submitted / traffic.bus_seconds : 0.0;
+}
+
+DrawRect PanelDisplay::flushArea(FlushStrategy strategy, const DrawRect& damage) const {
+    int x = 0, y = 0, w = screenWidth, h = screenHeight;
+    if (strategy != FlushStrategy::FULL_FRAME) {
+        if (damage.w == 0) return {0, 0, 0, 0};
+        y = damage.y;
+        h = damage.h;
+        if (strategy == FlushStrategy::DAMAGE_RECT) {
+            x = damage.x;
+            w = damage.w;
+        }
+        link->alignWindow(x, y, w, h);
+    }
+    return {static_cast<int16_t>(x), static_cast<int16_t>(y), static_cast<int16_t>(w), static_cast<int16_t>(h)};
+}
+
+// --- Recorded Frames ---
+void PanelDisplay::submit(DrawList& list) {
+    if (!link) return;
+    const DrawRect damage = list.damageWithin(screenWidth, screenHeight);
+    for (int s = 0; s < FLUSH_STRATEGY_COUNT; ++s) {
+        DrawRect area = flushArea(static_cast<FlushStrategy>(s), damage);
+        int writes = (area.h + strip_height - 1) / strip_height; // One memory write per strip
+        estimates[s].add(SpiPanel::windowCost(bus_config, area.w, area.h, writes));
+    }
+    frames_submitted++;
+
+    DrawRect area = flushArea(flush_strategy, damage);
+    if (area.w == 0) return;
+    list.cropTo(area);
+    strips.waitIdle(); // The previous frame's window must be finished before this one opens
+    frame_area = area;
+    window_open = false;
+    strips.render(list, area);
+    countComposited(frame, strips.compositorStats(), list);
+}
+
+void PanelDisplay::flushStrip(const DrawRect& area, const uint16_t* pixels) {
+    if (!window_open) {
+        // The frame's strips are stacked top to bottom, so one window spans all of them
+        link->setWindow(frame_area.x, frame_area.y, frame_area.w, frame_area.h);
+    }
+    link->writePixels(pixels, static_cast<size_t>(area.w) * area.h, window_open);
+    window_open = true;
+}
+
+void PanelDisplay::present() {
+    if (!link) return;
+    strips.waitIdle(); // Also makes the panel's counters safe to read
+
+    if (dirty_x1 > dirty_x0 && dirty_y1 > dirty_y0) {
+        // Immediate-mode drawing since the last present: send the touched part of the shadow
+        int x = dirty_x0, y = dirty_y0, w = dirty_x1 - dirty_x0, h = dirty_y1 - dirty_y0;
+        link->alignWindow(x, y, w, h);
+        link->setWindow(x, y, w, h);
+        for (int row = 0; row < h; ++row) {
+            link->writePixels(shadow.data() + static_cast<size_t>(y + row) * screenWidth + x, w, row > 0);
+        }
+        dirty_x0 = dirty_y0 = dirty_x1 = dirty_y1 = 0;
+    }
+
+    const PanelTraffic& total = link->traffic();
+    frame.texture_locks += total.windows - at_frame_start.windows; // One address window per update
+    frame.bytes_uploaded += total.bytes - at_frame_start.bytes;
+    at_frame_start = total;
+    last_frame = frame;
+    frame = {};
+}
+
+// --- Immediate Mode (debug) ---
+BlitSurface PanelDisplay::shadowSurface() {
+    if (shadow.empty()) shadow.assign(static_cast<size_t>(screenWidth) * screenHeight, 0x0000);
+    return {shadow.data(), screenWidth, screenHeight, screenWidth, PixelFormat::RGB565};
+}
+
+void PanelDisplay::markImmediate(int x, int y, int w, int h) {
+    int x1 = x + w < screenWidth ? x + w : screenWidth;
+    int y1 = y + h < screenHeight ? y + h : screenHeight;
+    x = x > 0 ? x : 0;
+    y = y > 0 ? y : 0;
+    if (x1 <= x || y1 <= y) return;
+    if (dirty_x1 <= dirty_x0) {
+        dirty_x0 = x; dirty_y0 = y; dirty_x1 = x1; dirty_y1 = y1;
+        return;
+    }
+    dirty_x0 = x < dirty_x0 ? x : dirty_x0;
+    dirty_y0 = y < dirty_y0 ? y : dirty_y0;
+    dirty_x1 = x1 > dirty_x1 ? x1 : dirty_x1;
+    dirty_y1 = y1 > dirty_y1 ? y1 : dirty_y1;
+}
+
+void PanelDisplay::clear(uint16_t color) {
+    if (!link) return;
+    fillRect(shadowSurface(), {0, 0, screenWidth, screenHeight}, color);
+    frame.pixels_cleared += static_cast<uint64_t>(screenWidth) * screenHeight;
+    markImmediate(0, 0, screenWidth, screenHeight);
+}
+
+void PanelDisplay::drawPixels(int destX, int destY, int width, int height,
+                              const uint16_t* pixelData,
+                              int sourceBufferWidth, int sourceBufferHeight,
+                              int sourceX, int sourceY)
+{
+    if (!pixelData || !link) return;
+    BlitSource source = {pixelData, sourceBufferWidth, sourceBufferHeight, sourceBufferWidth, PixelFormat::RGB565};
+    int visited = blit(shadowSurface(), nullptr, source, sourceX, sourceY, {destX, destY, width, height}, BLIT_KEY);
+    if (visited > 0) {
+        frame.blits[0]++;
+        frame.pixels_read[0] += visited;
+        frame.pixels_written[0] += visited;
+        markImmediate(destX, destY, width, height);
+    }
+}
+
+void PanelDisplay::drawCommand(const DrawCommand& cmd) {
+    if (!link) return;
+    int visited = blitDrawCommand(shadowSurface(), cmd);
+    if (visited > 0) {
+        const int slot = renderStatsSlot(cmd.layer);
+        frame.blits[slot]++;
+        frame.pixels_read[slot] += visited;
+        frame.pixels_written[slot] += visited;
+        markImmediate(cmd.clip.x, cmd.clip.y, cmd.clip.w, cmd.clip.h);
+    }
+}
@@ -0,0 +1,48 @@
+#include "platform/headless/ReplayInput.h"
+
+ReplayInput::ReplayInput(const InputRecording& recorded, GameClock& game_clock) :
+    recording(recorded),
+    clock(game_clock),
+    started(false),
+    start_ms(0),
+    next(0),
+    state{0, 0, 0},
+    steps(0),
+    quit_requested(false)
+{
+}
+
+uint32_t ReplayInput::sessionTime() const {
+    return clock.now() - start_ms;
+}
+
+void ReplayInput::update() {
+    if (!started) { // The recorder's clock started at its first update() too
+        started = true;
+        start_ms = clock.now();
+    }
+    state.pressed = state.released = 0;
+    steps = 0;
+    const uint32_t now = sessionTime();
+    for (; next < recording.frames.size() && recording.frames[next].time_ms <= now; ++next) {
+        const InputState& recorded = recording.frames[next].state;
+        steps += recording.frames[next].steps;
+        state.pressed |= recorded.pressed;
+        state.released |= recorded.released;
+        state.held = recorded.held;
+    }
+    // Like a live QUIT key, and the session is over where the recording stopped
+    if ((state.pressed & actionBit(InputAction::QUIT)) || now >= recording.end_ms) quit_requested = true;
+}
+
+bool ReplayInput::waitForInput(uint32_t timeout_ms) {
+    const uint32_t now = started ? sessionTime() : 0;
+    const uint32_t due = next < recording.frames.size() ? recording.frames[next].time_ms : recording.end_ms;
+    if (due <= now) return true;
+    if (due - now > timeout_ms) {
+        clock.sleep(timeout_ms);
+        return false;
+    }
+    clock.sleep(due - now);
+    return true;
+}
@@ -0,0 +1,95 @@
+#include "platform/headless/SpiPanel.h"
+
+static const size_t WINDOW_PARAMETER_BYTES = 4; // Start and end, 16 bits each
+
+SpiPanel::SpiPanel(int width, int height, const SpiBusConfig& bus) :
+    panel_width(width),
+    panel_height(height),
+    link(bus),
+    memory(static_cast<size_t>(width) * height, 0x0000),
+    window_x0(0),
+    window_y0(0),
+    window_x1(width - 1),
+    window_y1(height - 1),
+    cursor_x(0),
+    cursor_y(0),
+    total{}
+{
+}
+
+double SpiPanel::seconds(const SpiBusConfig& bus, size_t command_bytes, size_t data_bytes) {
+    double bits = 8.0 * command_bytes / bus.command_lanes + 8.0 * data_bytes / bus.data_lanes;
+    return bits / bus.clock_hz;
+}
+
+void SpiPanel::countCommand(size_t parameter_bytes) {
+    total.bytes += 1 + parameter_bytes;
+    total.transactions++;
+    total.bus_seconds += seconds(link, 1 + parameter_bytes, 0) + link.transaction_overhead_s;
+}
+
+void SpiPanel::setWindow(int x, int y, int w, int h) {
+    window_x0 = x;
+    window_y0 = y;
+    window_x1 = x + w - 1;
+    window_y1 = y + h - 1;
+    countCommand(WINDOW_PARAMETER_BYTES); // CASET
+    countCommand(WINDOW_PARAMETER_BYTES); // RASET
+    total.windows++;
+}
+
+void SpiPanel::writePixels(const uint16_t* pixels, size_t count, bool continuing) {
+    if (!continuing) { // RAMWR restarts at the window's top-left
+        cursor_x = window_x0;
+        cursor_y = window_y0;
+    }
+    const size_t data_bytes = count * sizeof(uint16_t);
+    total.bytes += 1 + data_bytes;
+    total.pixel_bytes += data_bytes;
+    total.transactions++;
+    total.bus_seconds += seconds(link, 1, data_bytes) + link.transaction_overhead_s;
+
+    // Fill the window row by row; like the controllers, wrap to the top once it's full
+    const int window_w = window_x1 - window_x0 + 1;
+    while (count > 0) {
+        size_t run = static_cast<size_t>(window_x1 - cursor_x + 1);
+        if (run > count) run = count;
+        if (cursor_x >= 0 && cursor_y >= 0 && window_x1 < panel_width && cursor_y < panel_height) {
+            uint16_t* row = memory.data() + static_cast<size_t>(cursor_y) * panel_width + cursor_x;
+            for (size_t i = 0; i < run; ++i) row[i] = pixels[i];
+        }
+        pixels += run;
+        count -= run;
+        cursor_x += static_cast<int>(run);
+        if (cursor_x > window_x1) {
+            cursor_x -= window_w;
+            cursor_y = cursor_y < window_y1 ? cursor_y + 1 : window_y0;
+        }
+    }
+}
+
+PanelTraffic SpiPanel::windowCost(const SpiBusConfig& bus, int w, int h, int writes) {
+    PanelTraffic cost = {};
+    if (w <= 0 || h <= 0) return cost;
+    const size_t data_bytes = static_cast<size_t>(w) * h * sizeof(uint16_t);
+    cost.windows = 1;
+    cost.transactions = 2 + writes;
+    cost.pixel_bytes = data_bytes;
+    cost.bytes = 2 * (1 + WINDOW_PARAMETER_BYTES) + writes + data_bytes;
+    cost.bus_seconds = seconds(bus, 2 * (1 + WINDOW_PARAMETER_BYTES) + writes, data_bytes) +
+                       cost.transactions * bus.transaction_overhead_s;
+    return cost;
+}
+
+void SpiPanel::alignWindow(int& x, int& y, int& w, int& h) const {
+    const int a = link.window_align > 1 ? link.window_align : 1;
+    int x1 = x + w, y1 = y + h;
+    x -= x % a;
+    y -= y % a;
+    x1 = (x1 + a - 1) / a * a;
+    y1 = (y1 + a - 1) / a * a;
+    if (x1 > panel_width) x1 = panel_width;
+    if (y1 > panel_height) y1 = panel_height;
+    w = x1 - x;
+    h = y1 - y;
+}
@@ -0,0 +1,111 @@
+#include "platform/headless/StripDisplay.h"
+#include "platform/DrawList.h"
+#include "Blitter.h"
+#include "SoftwareRenderer.h" // countComposited
+
+#include <chrono>
+#include <cstring>
+
+StripDisplay::StripDisplay(int strip_rows) :
+    strip_height(strip_rows),
+    bus_bytes_per_second(0.0),
+    screenWidth(0),
+    screenHeight(0),
+    flushed_bytes(0),
+    frame{},
+    last_frame{}
+{
+}
+
+StripDisplay::~StripDisplay() {
+    close();
+}
+
+bool StripDisplay::init(const char* /*title*/, int windowWidth, int windowHeight) {
+    if (windowWidth <= 0 || windowHeight <= 0) return false;
+    screenWidth = windowWidth;
+    screenHeight = windowHeight;
+    gram.assign(static_cast<size_t>(screenWidth) * screenHeight, 0x0000);
+    return strips.init(screenWidth, strip_height < screenHeight ? strip_height : screenHeight, this);
+}
+
+void StripDisplay::close() {
+    strips.shutdown();
+    gram.clear();
+    gram.shrink_to_fit();
+}
+
+BlitSurface StripDisplay::panelSurface() {
+    return {gram.data(), screenWidth, screenHeight, screenWidth, PixelFormat::RGB565};
+}
+
+void StripDisplay::clear(uint16_t color) {
+    if (gram.empty()) return;
+    strips.waitIdle();
+    fillRect(panelSurface(), {0, 0, screenWidth, screenHeight}, color);
+    frame.pixels_cleared += static_cast<uint64_t>(screenWidth) * screenHeight;
+}
+
+void StripDisplay::drawPixels(int destX, int destY, int width, int height,
+                              const uint16_t* pixelData,
+                              int sourceBufferWidth, int sourceBufferHeight,
+                              int sourceX, int sourceY)
+{
+    if (!pixelData || gram.empty()) return;
+    strips.waitIdle();
+    BlitSource source = {pixelData, sourceBufferWidth, sourceBufferHeight, sourceBufferWidth, PixelFormat::RGB565};
+    int visited = blit(panelSurface(), nullptr, source, sourceX, sourceY, {destX, destY, width, height}, BLIT_KEY);
+    if (visited > 0) {
+        frame.blits[0]++;
+        frame.pixels_read[0] += visited;
+        frame.pixels_written[0] += visited;
+    }
+}
+
+void StripDisplay::drawCommand(const DrawCommand& cmd) {
+    if (gram.empty()) return;
+    strips.waitIdle();
+    int visited = blitDrawCommand(panelSurface(), cmd);
+    if (visited > 0) {
+        const int slot = renderStatsSlot(cmd.layer);
+        frame.blits[slot]++;
+        frame.pixels_read[slot] += visited;
+        frame.pixels_written[slot] += visited;
+    }
+}
+
+void StripDisplay::submit(DrawList& list) {
+    // Only the damaged rows and columns are rendered and sent; the panel keeps the rest
+    DrawRect damage = list.damageWithin(screenWidth, screenHeight);
+    if (gram.empty() || damage.w == 0) return;
+    list.cropTo(damage);
+    strips.render(list, damage);
+    countComposited(frame, strips.compositorStats(), list);
+}
+
+void StripDisplay::present() {
+    strips.waitIdle(); // Also makes flushed_bytes safe to read
+    frame.texture_locks += strips.stats().strips; // One transfer per strip
+    frame.bytes_uploaded += flushed_bytes;
+    flushed_bytes = 0;
+    last_frame = frame;
+    frame = {};
+}
+
+void StripDisplay::flushStrip(const DrawRect& area, const uint16_t* pixels) {
+    auto start = std::chrono::steady_clock::now();
+    const size_t row_bytes = static_cast<size_t>(area.w) * sizeof(uint16_t);
+    for (int row = 0; row < area.h; ++row) {
+        std::memcpy(gram.data() + static_cast<size_t>(area.y + row) * screenWidth + area.x,
+                    pixels + static_cast<size_t>(row) * area.w, row_bytes);
+    }
+    flushed_bytes += row_bytes * area.h;
+
+    if (bus_bytes_per_second > 0.0) {
+        // Busy-wait out the transfer time: sleeps are far coarser than a strip's few microseconds
+        auto done = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(row_bytes * area.h / bus_bytes_per_second));
+        while (std::chrono::steady_clock::now() < done) {
+        }
+    }
+}
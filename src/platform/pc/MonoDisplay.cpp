@@ -0,0 +1,112 @@
+#include "platform/pc/MonoDisplay.h"
+#include "platform/DrawList.h"
+#include <SDL_log.h>
+
+MonoDisplay::MonoDisplay(int downscale) : mono(downscale), window(nullptr), renderer(nullptr), texture(nullptr) {}
+
+MonoDisplay::~MonoDisplay() {
+    close();
+}
+
+bool MonoDisplay::init(const char* title, int windowWidth, int windowHeight) {
+    if (!mono.init(windowWidth, windowHeight)) return false;
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL could not initialize! SDL_Error: %s", SDL_GetError());
+        return false;
+    }
+
+    window = SDL_CreateWindow(title, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, windowWidth, windowHeight, SDL_WINDOW_SHOWN);
+    if (!window) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Window could not be created! SDL_Error: %s", SDL_GetError());
+        close();
+        return false;
+    }
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!renderer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Renderer could not be created! SDL Error: %s", SDL_GetError());
+        close();
+        return false;
+    }
+
+    // Hard-edged dots when stretched
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, mono.width(), mono.height());
+    if (!texture) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Texture could not be created! SDL Error: %s", SDL_GetError());
+        close();
+        return false;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MonoDisplay Initialized (%dx%d dots, %d-bit words, shown at %dx%d)",
+                mono.width(), mono.height(), MONO_WORD_BITS, windowWidth, windowHeight);
+    return true;
+}
+
+void MonoDisplay::close() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+        renderer = nullptr;
+    }
+    if (window) {
+        SDL_DestroyWindow(window);
+        window = nullptr;
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MonoDisplay Closed resources");
+    }
+}
+
+void MonoDisplay::clear(uint16_t color) {
+    mono.clear(color);
+}
+
+void MonoDisplay::drawPixels(int destX, int destY, int width, int height,
+                             const uint16_t* pixelData,
+                             int sourceBufferWidth, int sourceBufferHeight,
+                             int sourceX, int sourceY)
+{
+    if (!pixelData) return;
+    DrawCommand cmd = {};
+    cmd.pixels = pixelData;
+    cmd.source_width = static_cast<int16_t>(sourceBufferWidth);
+    cmd.source_height = static_cast<int16_t>(sourceBufferHeight);
+    cmd.source_x = static_cast<int16_t>(sourceX);
+    cmd.source_y = static_cast<int16_t>(sourceY);
+    cmd.dest_x = static_cast<int16_t>(destX);
+    cmd.dest_y = static_cast<int16_t>(destY);
+    cmd.width = static_cast<int16_t>(width);
+    cmd.height = static_cast<int16_t>(height);
+    cmd.clip = {cmd.dest_x, cmd.dest_y, cmd.width, cmd.height};
+    cmd.flags = DRAW_COLOR_KEY;
+    mono.drawCommand(cmd);
+}
+
+void MonoDisplay::drawCommand(const DrawCommand& cmd) {
+    mono.drawCommand(cmd);
+}
+
+void MonoDisplay::submit(DrawList& list) {
+    mono.submit(list);
+}
+
+void MonoDisplay::present() {
+    if (!renderer || !texture) return;
+
+    // Expand the dots into LCD colours; the texture is only width x height dots
+    void* pixels = nullptr;
+    int pitch = 0;
+    if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0) {
+        for (int y = 0; y < mono.height(); ++y) {
+            uint32_t* row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) + static_cast<size_t>(y) * pitch);
+            const MonoWord* words = mono.frame() + static_cast<size_t>(y) * mono.wordsPerRow();
+            for (int x = 0; x < mono.width(); ++x) {
+                row[x] = ((words[x / MONO_WORD_BITS] >> (x % MONO_WORD_BITS)) & 1) ? LCD_INK : LCD_PAPER;
+            }
+        }
+        SDL_UnlockTexture(texture);
+    }
+    SDL_RenderCopy(renderer, texture, NULL, NULL);
+    SDL_RenderPresent(renderer);
+}
@@ -1,8 +1,11 @@
 #include "platform/pc/PCDisplay.h" // <<< Include the correct header
+#include "platform/DrawList.h"
 #include <SDL_log.h>
 #include <stdexcept>
 
-PCDisplay::PCDisplay() : window(nullptr), renderer(nullptr), texture(nullptr), screenWidth(0), screenHeight(0) {}
+PCDisplay::PCDisplay(bool render_thread) : window(nullptr), renderer(nullptr), texture(nullptr), screenWidth(0), screenHeight(0),
+    lockedPixels(nullptr), lockedPitch(0), lockedRect{0, 0, 0, 0}, uploadedBytes(0),
+    threaded(render_thread), frame_event(0), row_step(1), shown_counters{}, shown_stats{}, shown_composited(false), shown_sequence(0) {}
 
 // Destructor needs to clean up
 PCDisplay::~PCDisplay() {
@@ -31,8 +34,8 @@ bool PCDisplay::init(const char* title, int windowWidth, int windowHeight) {
         return false;
     }
 
-    // Create texture with ARGB8888 format for easier pixel manipulation
-    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, windowWidth, windowHeight);
+    // RGB565 texture: the assets' own format, so opaque copies need no conversion and uploads are half the size
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB565, SDL_TEXTUREACCESS_STREAMING, windowWidth, windowHeight);
     if (!texture) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Texture could not be created! SDL Error: %s", SDL_GetError());
         SDL_DestroyRenderer(renderer);
@@ -43,6 +46,7 @@ bool PCDisplay::init(const char* title, int windowWidth, int windowHeight) {
 
     screenWidth = windowWidth;
     screenHeight = windowHeight;
+    if (threaded) frame_event = SDL_RegisterEvents(1);
     // pixelBuffer.resize(screenWidth * screenHeight); // No longer needed if writing direct
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "PCDisplay Initialized (%dx%d)", screenWidth, screenHeight);
@@ -51,6 +55,8 @@ bool PCDisplay::init(const char* title, int windowWidth, int windowHeight) {
 
 void PCDisplay::close() {
     // Keep your original close logic
+    render_thread.stop(); // Before the window goes: nothing may wake the loop for it after this
+    unlockTexture();
     if (texture) {
         SDL_DestroyTexture(texture);
         texture = nullptr;
@@ -67,25 +73,10 @@ void PCDisplay::close() {
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "PCDisplay Closed resources");
 }
 
-// Keep your original helper function
-uint32_t PCDisplay::convertRGB565toARGB8888(uint16_t color) {
-    uint32_t r = (color & 0xF800) >> 11;
-    uint32_t g = (color & 0x07E0) >> 5;
-    uint32_t b = (color & 0x001F);
-    r = (r * 255) / 31;
-    g = (g * 255) / 63;
-    b = (b * 255) / 31;
-    return (0xFF << 24) | (r << 16) | (g << 8) | b; // Alpha = FF (opaque)
-}
-
 void PCDisplay::clear(uint16_t color) {
-    // Keep your original clear logic
-    uint32_t sdlColor = convertRGB565toARGB8888(color);
-    uint8_t r = (sdlColor >> 16) & 0xFF;
-    uint8_t g = (sdlColor >> 8) & 0xFF;
-    uint8_t b = sdlColor & 0xFF;
-    SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-    SDL_RenderClear(renderer);
+    // Fill the streaming texture itself: it is what present() copies to the screen
+    if (!texture || !lockTexture()) return;
+    software.clear(lockedSurface(), color);
 }
 
 void PCDisplay::drawPixels(int destX, int destY, int width, int height,
@@ -93,65 +84,129 @@ void PCDisplay::drawPixels(int destX, int destY, int width, int height,
                            int sourceBufferWidth, int sourceBufferHeight,
                            int sourceX, int sourceY)
 {
-    // Your existing drawPixels logic using SDL_LockTexture looks correct, keep it.
-    // Just ensure it matches the function signature from the header.
     if (!pixelData || !texture) return;
 
-    // Clip drawing rect (same clipping logic as before is fine)
-    int drawW = width;
-    int drawH = height;
-    int dX = destX;
-    int dY = destY;
-    int sX = sourceX;
-    int sY = sourceY;
-
-    if (dX < 0) { drawW += dX; sX -= dX; dX = 0; }
-    if (dY < 0) { drawH += dY; sY -= dY; dY = 0; }
-    if (dX + drawW > screenWidth) { drawW = screenWidth - dX; }
-    if (dY + drawH > screenHeight) { drawH = screenHeight - dY; }
-
-    if (drawW <= 0 || drawH <= 0) return; // Nothing to draw
-
-    // Lock texture for writing
-    void* texturePixels;
-    int pitch;
-    if (SDL_LockTexture(texture, NULL, &texturePixels, &pitch) != 0) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to lock texture: %s", SDL_GetError());
-        return;
-    }
+    // Lock texture for writing (stays locked for the rest of the frame)
+    if (!lockTexture()) return;
 
-    uint32_t* texBuffer = static_cast<uint32_t*>(texturePixels);
-    int texPitchInPixels = pitch / sizeof(uint32_t);
-
-    // Copy pixel data row by row, converting format
-    for (int y = 0; y < drawH; ++y) {
-        if (sY + y < 0 || sY + y >= sourceBufferHeight) continue;
-        if (dY + y < 0 || dY + y >= screenHeight) continue;
-
-        const uint16_t* srcRow = pixelData + (sY + y) * sourceBufferWidth + sX;
-        uint32_t* destRow = texBuffer + (dY + y) * texPitchInPixels + dX;
-
-        for (int x = 0; x < drawW; ++x) {
-            if (sX + x < 0 || sX + x >= sourceBufferWidth) continue;
-            if (dX + x < 0 || dX + x >= screenWidth) continue;
-
-            uint16_t srcColor = srcRow[x];
-             // Your original magenta key check:
-             if (srcColor != 0xF81F) { // Magenta Check (0b1111100000011111)
-                 destRow[x] = convertRGB565toARGB8888(srcColor);
-             } else {
-                 // Optional: If clearing wasn't perfect, explicitly set transparent pixels
-                 // destRow[x] = 0x00000000; // Fully transparent black
-             }
+    // Clipped once inside blit(); the kernel copies with the magenta colour key
+    software.drawPixels(lockedSurface(), destX, destY, width, height, pixelData,
+                        sourceBufferWidth, sourceBufferHeight, sourceX, sourceY);
+}
+
+void PCDisplay::drawCommand(const DrawCommand& cmd) {
+    if (!texture || !lockTexture()) return;
+    software.drawCommand(lockedSurface(), cmd);
+}
+
+// Locks the texture once per frame on the first draw, so a crowd of sprites costs one
+// lock/unlock pair instead of one per sprite. Unlocked again in present()/close().
+// Only 'rect' is locked, and only it is uploaded: frames that just redraw their damaged
+// region move a fraction of the texture. A later draw outside it re-locks.
+bool PCDisplay::lockTexture(const SDL_Rect& rect) {
+    if (lockedPixels) {
+        if (rect.x >= lockedRect.x && rect.y >= lockedRect.y && rect.x + rect.w <= lockedRect.x + lockedRect.w &&
+            rect.y + rect.h <= lockedRect.y + lockedRect.h) {
+            return true;
         }
+        unlockTexture();
     }
+    if (SDL_LockTexture(texture, &rect, &lockedPixels, &lockedPitch) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to lock texture: %s", SDL_GetError());
+        lockedPixels = nullptr;
+        return false;
+    }
+    lockedRect = rect;
+    software.countTextureLock();
+    return true;
+}
+
+void PCDisplay::unlockTexture() {
+    if (!lockedPixels) return;
     SDL_UnlockTexture(texture);
+    // Unlocking a streaming texture uploads the whole locked rect, however little was drawn
+    uploadedBytes += static_cast<uint64_t>(lockedRect.w) * lockedRect.h * sizeof(uint16_t);
+    lockedPixels = nullptr;
+    lockedPitch = 0;
 }
 
+BlitSurface PCDisplay::lockedSurface(const SDL_Rect& rect) const {
+    const int stride = lockedPitch / static_cast<int>(sizeof(uint16_t));
+    uint16_t* origin = static_cast<uint16_t*>(lockedPixels) +
+                       static_cast<size_t>(rect.y - lockedRect.y) * stride + (rect.x - lockedRect.x);
+    return {origin, rect.w, rect.h, stride, PixelFormat::RGB565};
+}
 
 void PCDisplay::present() {
     // Keep your original present logic
     if (!renderer || !texture) return;
+    unlockTexture();
+    if (threaded) {
+        // Upload the newest frame the render thread finished (none new: the texture still has the last)
+        if (const RenderedFrame* frame = render_thread.latestFrame()) {
+            SDL_UpdateTexture(texture, NULL, frame->pixels.data(), frame->width * bytesPerPixel(frame->format));
+            uploadedBytes += frame->pixels.size();
+            shown_counters = frame->counters;
+            shown_counters.bytes_uploaded = uploadedBytes;
+            shown_stats = frame->stats;
+            shown_composited = frame->composited;
+            shown_sequence = frame->sequence;
+        }
+    }
     SDL_RenderCopy(renderer, texture, NULL, NULL);
     SDL_RenderPresent(renderer);
-}
\ No newline at end of file
+    software.endFrame(uploadedBytes);
+    uploadedBytes = 0;
+}
+
+void PCDisplay::submit(DrawList& list) {
+    // Redraw (and upload) only the damaged region; the texture keeps the rest of the last frame
+    DrawRect damage = list.damageWithin(screenWidth, screenHeight, row_step);
+    if (!texture || damage.w == 0) return;
+    if (threaded) {
+        if (!render_thread.running() && !render_thread.start(screenWidth, screenHeight, PixelFormat::RGB565, this)) return;
+        render_thread.submit(list, software.heatMap(), row_step);
+        return;
+    }
+    SDL_Rect region = {damage.x, damage.y, damage.w, damage.h};
+    if (!lockTexture(region)) return;
+    list.cropTo(damage);
+    software.submit(lockedSurface(region), list);
+}
+
+// --- Render Thread Mode ---
+const CompositorStats* PCDisplay::compositorStats() const {
+    if (threaded) return shown_composited ? &shown_stats : nullptr;
+    return software.compositorStats();
+}
+
+const RenderCounters* PCDisplay::renderCounters() const {
+    return threaded ? &shown_counters : &software.counters();
+}
+
+bool PCDisplay::cacheLayer(const uint16_t* art, int width, int height, int period) {
+    if (threaded) {
+        return render_thread.cacheLayer(art, width, height, period);
+    }
+    return software.cacheLayer(art, width, height, period);
+}
+
+void PCDisplay::forgetSource(const uint16_t* pixels) {
+    if (threaded) {
+        render_thread.forgetSource(pixels);
+    } else {
+        software.forgetSource(pixels);
+    }
+}
+
+void PCDisplay::setCompositionRowStep(int step) {
+    row_step = step;
+    software.setRowStep(step);
+}
+
+void PCDisplay::frameReady() {
+    // Wake the game loop if it's waiting for input, so it presents the frame
+    SDL_Event event = {};
+    event.type = frame_event;
+    SDL_PushEvent(&event);
+}
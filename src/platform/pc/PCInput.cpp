@@ -1,56 +1,162 @@
 #include "platform/pc/PCInput.h" // <<< Include correct header
 #include <SDL_log.h>
+#include <stdio.h>
+#include <string.h>
 
-PCInput::PCInput() : quitRequested(false) {
-    // --- Define Key Mappings ---
-    keyActionMap[SDLK_ESCAPE] = InputAction::QUIT;
-    keyActionMap[SDLK_SPACE] = InputAction::STEP; // Use spacebar to simulate a shake/step
-    keyActionMap[SDLK_1] = InputAction::SELECT_DIGI_1;
-    keyActionMap[SDLK_2] = InputAction::SELECT_DIGI_2;
-    keyActionMap[SDLK_3] = InputAction::SELECT_DIGI_3;
-    keyActionMap[SDLK_4] = InputAction::SELECT_DIGI_4;
-    keyActionMap[SDLK_5] = InputAction::SELECT_DIGI_5;
-    keyActionMap[SDLK_6] = InputAction::SELECT_DIGI_6;
-    keyActionMap[SDLK_7] = InputAction::SELECT_DIGI_7;
-    keyActionMap[SDLK_8] = InputAction::SELECT_DIGI_8;
-    // Add more mappings here later (arrows, enter, etc.)
+PCInput::PCInput() : keys_down{}, key_down{}, state{0, 0, 0}, quitRequested(false), press_timestamp(0), events_dropped(0) {
+    // --- Define Key Mappings (replaced by loadBindings) ---
+    clearBindings();
+    bind(SDL_SCANCODE_ESCAPE, InputAction::QUIT);
+    bind(SDL_SCANCODE_SPACE, InputAction::STEP); // Use spacebar to simulate a shake/step
+    bind(SDL_SCANCODE_RIGHT, InputAction::SELECT_NEXT);
+    bind(SDL_SCANCODE_LEFT, InputAction::SELECT_PREV);
+    bind(SDL_GetScancodeFromName("C"), InputAction::TOGGLE_CROWD);
+    bind(SDL_GetScancodeFromName("H"), InputAction::TOGGLE_HEATMAP);
+    bind(SDL_GetScancodeFromName("N"), InputAction::NEXT_SCENE);
+
+    SDL_AddEventWatch(&PCInput::eventWatch, this);
 }
 
-void PCInput::update() {
-    // Clear the per-frame action set
-    pressedActions.clear();
+PCInput::~PCInput() {
+    SDL_DelEventWatch(&PCInput::eventWatch, this);
+}
 
-    SDL_Event e;
-    // Process all pending events this frame
-    while (SDL_PollEvent(&e) != 0) {
-        if (e.type == SDL_QUIT) {
-            quitRequested = true;
-        } else if (e.type == SDL_KEYDOWN) {
-            // Only register the first press (repeat == 0)
-            if (e.key.repeat == 0) {
-                auto it = keyActionMap.find(e.key.keysym.sym);
-                if (it != keyActionMap.end()) {
-                    InputAction action = it->second;
-                    pressedActions.insert(action);
-                    // If the action is QUIT, also set the flag immediately
-                    if(action == InputAction::QUIT) {
-                        quitRequested = true;
-                    }
+void PCInput::bind(SDL_Scancode key, InputAction action) {
+    if (key <= SDL_SCANCODE_UNKNOWN || key >= SDL_NUM_SCANCODES) return;
+    key_actions[key] = static_cast<uint8_t>(action);
+}
+
+void PCInput::clearBindings() {
+    memset(key_actions, static_cast<int>(InputAction::UNKNOWN), sizeof(key_actions));
+}
+
+// --- Binding Files ---
+bool PCInput::loadBindings(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s: cannot open", path);
+        return false;
+    }
+    // Parsed into a copy, so a bad file leaves the current bindings alone
+    uint8_t parsed[SDL_NUM_SCANCODES];
+    memset(parsed, static_cast<int>(InputAction::UNKNOWN), sizeof(parsed));
+    char line[256];
+    int line_number = 0, bound = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file)) {
+        line_number++;
+        if (char* comment = strchr(line, '#')) *comment = '\0';
+        char directive[32], key_name[64], action_name[64], extra[2];
+        int fields = sscanf(line, "%31s %63s %63s %1s", directive, key_name, action_name, extra);
+        if (fields <= 0) continue; // Blank or comment
+        ok = false;
+        if (strcmp(directive, "bind") != 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s:%d: unknown directive '%s'", path, line_number, directive);
+        } else if (fields != 3) {
+            SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s:%d: expected 'bind <key> <action>'", path, line_number);
+        } else {
+            SDL_Scancode key = SDL_GetScancodeFromName(key_name);
+            InputAction action = inputActionFromName(action_name);
+            if (key == SDL_SCANCODE_UNKNOWN) {
+                SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s:%d: unknown key '%s'", path, line_number, key_name);
+            } else if (action == InputAction::UNKNOWN) {
+                SDL_LogError(SDL_LOG_CATEGORY_INPUT, "%s:%d: unknown action '%s'", path, line_number, action_name);
+            } else {
+                if (parsed[key] != static_cast<uint8_t>(InputAction::UNKNOWN)) {
+                    SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "%s:%d: '%s' was bound to %s", path, line_number, key_name,
+                                inputActionName(static_cast<InputAction>(parsed[key])));
                 }
+                parsed[key] = static_cast<uint8_t>(action);
+                bound++;
+                ok = true;
             }
         }
-        // We don't need key up handling for now, but could add it here
-        // else if (e.type == SDL_KEYUP) { ... }
-        // Add Touch Input handling here later if needed
-        // else if (e.type == SDL_FINGERDOWN ...) { ... }
     }
+    fclose(file);
+    if (!ok) return false;
+
+    memcpy(key_actions, parsed, sizeof(key_actions));
+    // Held keys now stand for other actions (or none): start them over
+    memset(key_down, 0, sizeof(key_down));
+    memset(keys_down, 0, sizeof(keys_down));
+    state.held = 0;
+    SDL_Log("Loaded %d key bindings from %s", bound, path);
+    return true;
 }
 
-bool PCInput::wasActionPressed(InputAction action) const {
-    // Check if the action exists in the set of actions pressed this frame
-    return pressedActions.count(action);
+// Called for every event as SDL queues it, on the thread queueing it. Only keyboard and
+// quit events go on: those come from the thread pumping SDL's events (the main thread), which
+// keeps 'events' single-producer; user events pushed from other threads are let through untouched.
+int PCInput::eventWatch(void* userdata, SDL_Event* event) {
+    PCInput* self = static_cast<PCInput*>(userdata);
+    KeyEvent key = {0, WINDOW_QUIT, 0};
+    if (event->type == SDL_QUIT) {
+        key.type = WINDOW_QUIT;
+    } else if ((event->type == SDL_KEYDOWN || event->type == SDL_KEYUP) && event->key.repeat == 0) {
+        key.type = event->type == SDL_KEYDOWN ? KEY_DOWN : KEY_UP;
+        key.scancode = static_cast<uint16_t>(event->key.keysym.scancode);
+    } else {
+        return 1;
+    }
+    key.timestamp = SDL_GetPerformanceCounter();
+    if (!self->events.push(key)) self->events_dropped.fetch_add(1, std::memory_order_relaxed);
+    return 1;
+}
+
+void PCInput::update() {
+    // This frame's edges start empty; 'held' carries over
+    state.pressed = state.released = 0;
+    press_timestamp = 0;
+
+    // Empty SDL's own queue: the watch has already passed on what matters
+    SDL_Event e;
+    while (SDL_PollEvent(&e) != 0) {
+    }
+
+    KeyEvent key;
+    while (events.pop(key)) handleKey(key);
+
+    uint32_t dropped = events_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped) SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "Input queue full: %u key events dropped", dropped);
+}
+
+bool PCInput::waitForInput(uint32_t timeout_ms) {
+    if (!events.empty()) return true; // Still waiting to be handled
+    SDL_Event e; // Whatever it is, the watch has seen it
+    return SDL_WaitEventTimeout(&e, static_cast<int>(timeout_ms)) != 0;
+}
+
+void PCInput::handleKey(const KeyEvent& e) {
+    if (e.type == WINDOW_QUIT) {
+        quitRequested = true;
+        return;
+    }
+    if (e.scancode >= SDL_NUM_SCANCODES) return;
+    const int action = key_actions[e.scancode];
+    if (action >= INPUT_ACTION_COUNT) return; // Unbound
+    const uint32_t bit = 1u << action;
+
+    if (e.type == KEY_DOWN) {
+        if (key_down[e.scancode]) return;
+        key_down[e.scancode] = true;
+        if (keys_down[action]++ == 0) state.held |= bit;
+        state.pressed |= bit;
+        if (press_timestamp == 0) press_timestamp = e.timestamp; // Events arrive in order: the first is the earliest
+        // If the action is QUIT, also set the flag immediately
+        if (action == static_cast<int>(InputAction::QUIT)) {
+            quitRequested = true;
+        }
+    } else {
+        if (!key_down[e.scancode]) return; // Went down before a rebind
+        key_down[e.scancode] = false;
+        if (--keys_down[action] == 0) {
+            state.held &= ~bit;
+            state.released |= bit;
+        }
+    }
+    // Add Touch Input handling here later if needed
 }
 
 bool PCInput::isQuitRequested() const {
     return quitRequested;
-}
\ No newline at end of file
+}